@@ -0,0 +1,45 @@
+pragma ComponentBehavior: Bound
+import QtQuick
+import TheoIDE.Controls
+import TheoIDE.Persistence
+
+Column {
+    id: root
+
+    required property CallStackModel model
+
+    spacing: 2
+
+    Repeater {
+        model: root.model
+        delegate: Column {
+            id: frame
+            required property string frameName
+            required property bool isExpanded
+            required property var frameVariables
+            required property var model
+
+            spacing: 2
+
+            TableCell {
+                text: (frame.isExpanded ? "▾ " : "▸ ") + frame.frameName
+                horizontalAlignment: Text.AlignLeft
+                width: root.width
+                MouseArea {
+                    anchors.fill: parent
+                    onClicked: frame.model.isExpanded = !frame.isExpanded
+                }
+            }
+
+            Repeater {
+                model: frame.frameVariables
+                delegate: TableCell {
+                    required property var modelData
+                    text: modelData.name + ": " + modelData.value
+                    horizontalAlignment: Text.AlignLeft
+                    width: root.width
+                }
+            }
+        }
+    }
+}
@@ -48,9 +48,10 @@ Item {
             delegate: ClosableTabButton {
                 required property string displayTabName
                 required property bool isReadOnly
+                required property int executionState
                 required property var model
                 onCloseTriggered: model.open = false
-                text: displayTabName
+                text: executionState === ExecutionState.Idle ? displayTabName : displayTabName + " ●"
                 width: implicitWidth
                 closeEnabled: !isReadOnly
             }
@@ -77,20 +78,45 @@ Item {
 
         Repeater {
             model: root.model
-            delegate: TabContent {
+            delegate: Loader {
+                id: tabLoader
                 required property string storedTabText
                 required property var model
                 required property int cursorPosition
                 required property int cursorLineNumber
-                currentCursorPosition: cursorPosition
-                onCurrentCursorPositionChanged: {
-                    model.cursorPositionEdit = currentCursorPosition;
+                required property LargeFileModel largeFileModel
+                required property bool isHibernated
+                active: !isHibernated
+                sourceComponent: largeFileModel ? largeFileContent : textContent
+
+                Component {
+                    id: textContent
+                    TabContent {
+                        currentCursorPosition: tabLoader.cursorPosition
+                        onCurrentCursorPositionChanged: {
+                            tabLoader.model.cursorPositionEdit = currentCursorPosition;
+                        }
+                        currentLineNumber: tabLoader.cursorLineNumber
+                        // The stored text is released once the document is
+                        // handed to the model, so it must not stay bound.
+                        // Setting the text moves the cursor, the position of
+                        // a woken tab is restored before rebinding it.
+                        Component.onCompleted: {
+                            const restoredCursorPosition = tabLoader.cursorPosition;
+                            text = tabLoader.storedTabText;
+                            tabLoader.model.textDocument = textDocument;
+                            currentCursorPosition = restoredCursorPosition;
+                            currentCursorPosition = Qt.binding(() => tabLoader.cursorPosition);
+                            tabLoader.model.cursorPositionEdit = currentCursorPosition;
+                        }
+                    }
                 }
-                currentLineNumber: cursorLineNumber
-                text: storedTabText
-                Component.onCompleted: {
-                    model.textDocument = textDocument;
-                    model.cursorPositionEdit = currentCursorPosition;
+
+                Component {
+                    id: largeFileContent
+                    LargeFileView {
+                        model: tabLoader.largeFileModel
+                    }
                 }
             }
         }
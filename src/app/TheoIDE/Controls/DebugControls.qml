@@ -11,8 +11,12 @@ ToolBar {
     }
 
     property bool autoStepEnabled: false
+    property bool halted: false
     signal stepToNextBreakpointTriggered
     signal stepTriggered
+    signal stepOverTriggered
+    signal stepOutTriggered
+    signal runToCursorTriggered
 
     Action {
         id: stepNextAction
@@ -26,6 +30,30 @@ ToolBar {
         icon.name: "step"
     }
 
+    Action {
+        id: stepOverAction
+        text: qsTr("Step Over")
+        icon.name: "step_over"
+        enabled: root.halted
+        onTriggered: root.stepOverTriggered()
+    }
+
+    Action {
+        id: stepOutAction
+        text: qsTr("Step Out")
+        icon.name: "step_out"
+        enabled: root.halted
+        onTriggered: root.stepOutTriggered()
+    }
+
+    Action {
+        id: runToCursorAction
+        text: qsTr("Run to Cursor")
+        icon.name: "run_to_cursor"
+        enabled: root.halted
+        onTriggered: root.runToCursorTriggered()
+    }
+
     Action {
         id: restartAction
         text: qsTr("Restart")
@@ -63,6 +91,21 @@ ToolBar {
             display: AbstractButton.IconOnly
             icon.color: ApplicationSettings.foreground
         }
+        ToolButton {
+            action: stepOverAction
+            display: AbstractButton.IconOnly
+            icon.color: ApplicationSettings.foreground
+        }
+        ToolButton {
+            action: stepOutAction
+            display: AbstractButton.IconOnly
+            icon.color: ApplicationSettings.foreground
+        }
+        ToolButton {
+            action: runToCursorAction
+            display: AbstractButton.IconOnly
+            icon.color: ApplicationSettings.foreground
+        }
         ToolButton {
             action: root.autoStepEnabled ? disableAutoStepAction : enableAutoStepAction
             display: AbstractButton.IconOnly
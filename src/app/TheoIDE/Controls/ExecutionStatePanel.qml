@@ -2,6 +2,7 @@ import QtQuick
 import QtQuick.Controls.Material
 import QtQuick.Layouts
 import TheoIDE.Controls
+import TheoIDE.Models
 import TheoIDE.Persistence
 
 Item {
@@ -10,6 +11,7 @@ Item {
     property bool autoStepEnabled: false
     property alias implicitWidth: debugControls.implicitWidth
     required property EditorModel model
+    readonly property VirtualMachineService service: root.model.currentSession ? root.model.currentSession.virtualMachineService : root.model.virtualMachineService
 
     states: [
         State {
@@ -20,11 +22,6 @@ Item {
         State {
             name: "running"
             when: root.model.executionState !== ExecutionState.Idle && root.model.runningMode === EditorModel.Default
-            PropertyChanges {
-                mainTabComboBox {
-                    enabled: false
-                }
-            }
         }
     ]
 
@@ -50,6 +47,10 @@ Item {
                 rightPadding: 8
                 width: implicitWidth
                 height: implicitHeight
+                halted: root.model.executionState === ExecutionState.Halt
+                onStepOverTriggered: root.model.stepOver()
+                onStepOutTriggered: root.model.stepOut()
+                onRunToCursorTriggered: root.model.runToCursor()
             }
         }
 
@@ -137,6 +138,51 @@ Item {
                 }
             }
 
+            Switch {
+                width: parent.contentWidth
+                text: qsTr("Live Variables")
+                checked: ApplicationSettings.liveVariablesEnabled
+                onToggled: ApplicationSettings.liveVariablesEnabled = checked
+            }
+
+            Switch {
+                width: parent.contentWidth
+                text: qsTr("Cache Results")
+                checked: ApplicationSettings.executionCacheEnabled
+                onToggled: ApplicationSettings.executionCacheEnabled = checked
+            }
+
+            Switch {
+                width: parent.contentWidth
+                text: qsTr("Run in Separate Process")
+                checked: ApplicationSettings.isolatedExecutionEnabled
+                onToggled: ApplicationSettings.isolatedExecutionEnabled = checked
+            }
+
+            Switch {
+                width: parent.contentWidth
+                text: qsTr("Record Executions")
+                checked: ApplicationSettings.executionRecordingEnabled
+                onToggled: ApplicationSettings.executionRecordingEnabled = checked
+            }
+
+            LabeledControl {
+                width: parent.contentWidth
+                visible: root.service?.isReplaying ?? false
+                text: qsTr("Replay")
+                Slider {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    enabled: root.model.executionState === ExecutionState.Halt
+                    from: 0
+                    to: Math.max(0, (root.service?.replayRecordCount ?? 1) - 1)
+                    stepSize: 1
+                    snapMode: Slider.SnapAlways
+                    value: root.service?.replayPosition ?? 0
+                    onMoved: root.service.seekReplayRecord(value)
+                }
+            }
+
             LabeledControl {
                 width: parent.contentWidth
                 text: qsTr("Output")
@@ -151,11 +197,82 @@ Item {
                         anchors.right: parent.right
                         height: implicitHeight
                         model: VariablesStateModel {
-                            virtualMachineService: root.model.virtualMachineService
+                            virtualMachineService: root.service
+                        }
+                    }
+                }
+            }
+
+            LabeledControl {
+                width: parent.contentWidth
+                text: qsTr("Watches")
+                WatchPanel {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    model: WatchModel {
+                        virtualMachineService: root.service
+                    }
+                }
+            }
+
+            LabeledControl {
+                width: parent.contentWidth
+                text: qsTr("Call Stack")
+                CallStackView {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    model: CallStackModel {
+                        virtualMachineService: root.service
+                    }
+                }
+            }
+
+            LabeledControl {
+                width: parent.contentWidth
+                text: qsTr("Statistics")
+                Label {
+                    readonly property VirtualMachineService service: root.service
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    wrapMode: Text.Wrap
+                    text: service ? qsTr("Peak call depth: %1, executed instructions: %2, halts: %3, peak memory: %4").arg(service.peakCallStackDepth).arg(service.executedInstructions).arg(service.haltCount).arg(Qt.locale().formattedDataSize(service.peakMemoryBytes)) : ""
+                }
+                Label {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    visible: root.service?.lastResultFromCache ?? false
+                    wrapMode: Text.Wrap
+                    text: qsTr("Result served from cache")
+                }
+            }
+
+            LabeledControl {
+                width: parent.contentWidth
+                text: qsTr("Console")
+                ReplConsole {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    model: ReplModel {
+                        replService: ReplService {
+                            timeoutMs: ApplicationSettings.executionTimeoutMs
+                            memoryLimitBytes: ApplicationSettings.executionMemoryLimitBytes
                         }
                     }
                 }
             }
+
+            LabeledControl {
+                width: parent.contentWidth
+                text: qsTr("Parameter Sweep")
+                SweepPanel {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    model: SweepModel {
+                        editorModel: root.model
+                        virtualMachineService: root.model.virtualMachineService
+                    }
+                }
+            }
         }
     }
 }
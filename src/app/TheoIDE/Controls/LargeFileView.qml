@@ -0,0 +1,111 @@
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls.Material
+import TheoIDE.Controls
+import TheoIDE.Persistence
+
+// Only the lines inside the viewport are instantiated, the text itself stays
+// in the piece table of the model.
+ListView {
+    id: root
+
+    readonly property int innerMargin: 8
+    readonly property real lineHeight: fontMetrics.height
+    readonly property real gutterWidth: fontMetrics.advanceWidth(String(count)) + 2 * innerMargin
+    // Typed text is written to the model after this pause, when the line
+    // loses focus, before its delegate is reused and before the model text is
+    // read.
+    readonly property int commitDelayMs: 300
+
+    clip: true
+    reuseItems: true
+    boundsBehavior: Flickable.StopAtBounds
+    topMargin: innerMargin
+    bottomMargin: innerMargin
+    contentWidth: width
+    flickableDirection: Flickable.AutoFlickIfNeeded
+    ScrollBar.vertical: ScrollBar {}
+
+    FontMetrics {
+        id: fontMetrics
+        font.family: ApplicationSettings.editorFontFamily
+        font.pointSize: ApplicationSettings.editorFontSize
+    }
+
+    delegate: Item {
+        id: line
+        required property int index
+        required property string lineText
+        required property var model
+
+        width: root.width
+        height: root.lineHeight
+
+        ListView.onPooled: commit()
+
+        Timer {
+            id: commitTimer
+            interval: root.commitDelayMs
+            onTriggered: line.commit()
+        }
+
+        Connections {
+            target: root.model
+            function onAboutToReadText(): void {
+                line.commit();
+            }
+        }
+
+        Text {
+            id: lineNumber
+            width: root.gutterWidth
+            height: parent.height
+            rightPadding: root.innerMargin
+            horizontalAlignment: Text.AlignRight
+            text: line.index + 1
+            font: fontMetrics.font
+            color: Qt.tint(ApplicationSettings.foreground, Qt.alpha(ApplicationSettings.background, 0.4))
+        }
+
+        TextInput {
+            id: lineInput
+            anchors.left: lineNumber.right
+            anchors.right: parent.right
+            height: parent.height
+            clip: true
+            text: line.lineText
+            font: fontMetrics.font
+            color: ApplicationSettings.foreground
+            selectionColor: ApplicationSettings.accent
+            selectByMouse: true
+            onTextEdited: commitTimer.restart()
+            onEditingFinished: line.commit()
+            Keys.onReturnPressed: function (event) {
+                line.splitAtCursor(event);
+            }
+            Keys.onEnterPressed: function (event) {
+                line.splitAtCursor(event);
+            }
+            Keys.onPressed: function (event) {
+                if (event.key === Qt.Key_Backspace && cursorPosition === 0 && selectedText.length === 0 && line.index > 0) {
+                    line.commit();
+                    root.model.joinWithPreviousLine(line.index);
+                    event.accepted = true;
+                }
+            }
+        }
+
+        function commit(): void {
+            commitTimer.stop();
+            if (lineInput.text !== lineText) {
+                model.lineText = lineInput.text;
+            }
+        }
+
+        function splitAtCursor(event: KeyEvent): void {
+            commit();
+            root.model.splitLine(index, lineInput.cursorPosition);
+            event.accepted = true;
+        }
+    }
+}
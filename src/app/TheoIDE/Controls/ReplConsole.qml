@@ -0,0 +1,56 @@
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls.Material
+import TheoIDE.Controls
+import TheoIDE.Models
+import TheoIDE.Persistence
+
+Column {
+    id: root
+
+    required property ReplModel model
+    readonly property bool isEvaluating: root.model.replService?.isEvaluating ?? false
+
+    spacing: 2
+
+    Repeater {
+        model: root.model
+        delegate: Column {
+            id: entry
+            required property string input
+            required property string output
+            required property bool succeeded
+
+            spacing: 2
+
+            TableCell {
+                text: "> " + entry.input
+                horizontalAlignment: Text.AlignLeft
+                width: root.width
+            }
+            TableCell {
+                text: entry.succeeded ? entry.output : qsTr("Error: %1").arg(entry.output)
+                horizontalAlignment: Text.AlignLeft
+                width: root.width
+            }
+        }
+    }
+
+    TextField {
+        id: snippetInput
+        anchors.left: parent.left
+        anchors.right: parent.right
+        font: ApplicationSettings.editorFont
+        placeholderText: qsTr("Enter a statement and press Enter")
+        enabled: !root.isEvaluating
+        onAccepted: {
+            root.model.replService.evaluate(text);
+            clear();
+        }
+    }
+
+    Button {
+        text: qsTr("Clear Console")
+        onClicked: root.model.clear()
+    }
+}
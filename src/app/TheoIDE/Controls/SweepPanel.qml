@@ -0,0 +1,58 @@
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls.Material
+import TheoIDE.Controls
+import TheoIDE.Models
+import TheoIDE.Persistence
+
+Column {
+    id: root
+
+    required property SweepModel model
+    readonly property bool isSweeping: root.model.virtualMachineService?.isSweeping ?? false
+
+    spacing: 2
+
+    TextArea {
+        id: variantsInput
+        anchors.left: parent.left
+        anchors.right: parent.right
+        placeholderText: qsTr("One variant per line, e.g. x1=1, x2=5")
+        font: ApplicationSettings.editorFont
+        wrapMode: TextEdit.NoWrap
+    }
+
+    Row {
+        spacing: 8
+        Button {
+            text: qsTr("Run Sweep")
+            enabled: !root.isSweeping && variantsInput.text.length > 0
+            onClicked: root.model.start(variantsInput.text)
+        }
+        Button {
+            text: qsTr("Stop")
+            enabled: root.isSweeping
+            onClicked: root.model.stop()
+        }
+        Label {
+            anchors.verticalCenter: parent.verticalCenter
+            text: qsTr("%1 / %2").arg(resultsRepeater.count).arg(root.model.variantCount)
+            visible: root.model.variantCount > 0
+        }
+    }
+
+    Repeater {
+        id: resultsRepeater
+        model: root.model
+        delegate: TableCell {
+            required property int variantIndex
+            required property string overrides
+            required property string variables
+            required property bool succeeded
+            required property string error
+            text: "#" + (variantIndex + 1) + " [" + overrides + "] " + (succeeded ? variables : error)
+            horizontalAlignment: Text.AlignLeft
+            width: root.width
+        }
+    }
+}
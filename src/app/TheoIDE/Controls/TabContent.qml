@@ -1,11 +1,10 @@
 import QtQuick
+import QtQuick.Controls.Material
 import TheoIDE.Persistence
 import TheoIDE.Controls
 
 Item {
     id: root
-    property alias currentIndex: lineInfoColumn.currentIndex
-    property alias currentItem: lineInfoColumn.currentItem
     readonly property int innerMargin: 8
     property alias text: textEdit.text
     property alias textDocument: textEdit.textDocument
@@ -17,49 +16,54 @@ Item {
         color: ApplicationSettings.currentLineBackground
         anchors.left: parent.left
         anchors.right: parent.right
-        height: parent.currentItem ? parent.currentItem.height : 0
-        y: lineInfoColumn.currentItem ? lineInfoColumn.currentItem.y - lineInfoColumn.contentY : 0
+        height: lineHeight
+        y: lineOffset + lineInfoGutter.topMargin - lineInfoGutter.contentY
         z: 0
+
+        property real lineOffset: 0
+        property real lineHeight: 0
+
+        function updateGeometry(): void {
+            const lineIndex = root.currentLineNumber - 1;
+            lineOffset = lineInfoColumnModel.lineOffsetAt(lineIndex);
+            lineHeight = lineInfoColumnModel.lineHeightAt(lineIndex);
+        }
+
+        Component.onCompleted: {
+            root.currentLineNumberChanged.connect(updateGeometry);
+            lineInfoColumnModel.lineHeightsChanged.connect(updateGeometry);
+            updateGeometry();
+        }
     }
 
-    LineInfoColumn {
-        id: lineInfoColumn
+    LineInfoGutter {
+        id: lineInfoGutter
         anchors.left: parent.left
         anchors.top: parent.top
         anchors.bottom: parent.bottom
-        leftMargin: root.innerMargin
-        rightMargin: root.innerMargin
-        bottomMargin: root.innerMargin
-        topMargin: root.innerMargin
         width: implicitWidth
-        currentIndex: root.currentLineNumber - 1
+        topMargin: root.innerMargin
+        horizontalPadding: root.innerMargin
         model: LineInfoColumnModel {
             id: lineInfoColumnModel
             textDocument: textEdit.textDocument
         }
         contentY: textEdit.contentY
-        interactive: false
-        z: 1
-
-        readonly property int currentLineIndex: root.currentLineNumber - 1
-
-        function updateCurrentIndex(): void {
-            if (currentLineIndex >= count) {
-                return;
-            }
-            currentIndex = currentLineIndex;
-        }
-
-        Component.onCompleted: {
-            root.currentLineNumberChanged.connect(updateCurrentIndex);
-            lineInfoColumn.countChanged.connect(updateCurrentIndex);
+        font {
+            pointSize: ApplicationSettings.editorFontSize
+            family: ApplicationSettings.editorFontFamily
         }
+        textColor: Qt.tint(ApplicationSettings.foreground, Qt.alpha(ApplicationSettings.background, 0.4))
+        hoverColor: Material.theme === Material.Dark ? "#19ffffff" : "#19000000"
+        breakPointColor: ApplicationSettings.accent
+        breakPointTextColor: ApplicationSettings.background
+        z: 1
     }
 
     PlainTextEditor {
         id: textEdit
         anchors.top: parent.top
-        anchors.left: lineInfoColumn.right
+        anchors.left: lineInfoGutter.right
         anchors.right: parent.right
         anchors.bottom: parent.bottom
         innerMargin: root.innerMargin
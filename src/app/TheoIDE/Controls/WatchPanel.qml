@@ -0,0 +1,50 @@
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls.Material
+import TheoIDE.Controls
+import TheoIDE.Models
+import TheoIDE.Persistence
+
+Column {
+    id: root
+
+    required property WatchModel model
+
+    spacing: 2
+
+    Repeater {
+        model: root.model
+        delegate: Row {
+            id: watch
+            required property int index
+            required property string expression
+            required property var value
+            required property string error
+
+            spacing: 2
+
+            TableCell {
+                text: watch.expression + " = " + (watch.error.length > 0 ? watch.error : watch.value)
+                horizontalAlignment: Text.AlignLeft
+                width: root.width - removeButton.width - watch.spacing
+            }
+            ToolButton {
+                id: removeButton
+                icon.name: "close"
+                onClicked: root.model.remove(watch.index)
+            }
+        }
+    }
+
+    TextField {
+        anchors.left: parent.left
+        anchors.right: parent.right
+        font: ApplicationSettings.editorFont
+        placeholderText: qsTr("Add a watch expression, e.g. x1 * 2 + x2")
+        onAccepted: {
+            if (root.model.add(text)) {
+                clear();
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#include <QTextBlock>
+#include <algorithm>
+
+#include "breakpointstore.hpp"
+
+BreakPointStore* BreakPointStore::of(QTextDocument* textDocument) {
+  if (textDocument == nullptr) {
+    return nullptr;
+  }
+  BreakPointStore* store = textDocument->findChild<BreakPointStore*>(
+      QString(), Qt::FindDirectChildrenOnly);
+  if (store == nullptr) {
+    store = new BreakPointStore(textDocument);
+  }
+  return store;
+}
+
+BreakPointStore::BreakPointStore(QTextDocument* textDocument)
+    : QObject(textDocument),
+      _textDocument(textDocument),
+      _blockCount(textDocument->blockCount()) {
+  connect(_textDocument, &QTextDocument::contentsChange, this,
+          &BreakPointStore::handleContentsChange);
+}
+
+BreakPointStore::~BreakPointStore() {}
+
+const QList<int>& BreakPointStore::lineNumbers() const { return _lineNumbers; }
+
+bool BreakPointStore::contains(int lineNumber) const {
+  return std::binary_search(_lineNumbers.cbegin(), _lineNumbers.cend(),
+                            lineNumber);
+}
+
+bool BreakPointStore::setBreakPoint(int lineNumber, bool active) {
+  if (lineNumber < 1 || lineNumber > _blockCount) {
+    return false;
+  }
+  const auto position =
+      std::lower_bound(_lineNumbers.begin(), _lineNumbers.end(), lineNumber);
+  const bool currentlyActive =
+      position != _lineNumbers.end() && *position == lineNumber;
+  if (currentlyActive == active) {
+    return true;
+  }
+  const qsizetype index = position - _lineNumbers.begin();
+  if (active) {
+    _lineNumbers.insert(index, lineNumber);
+    _linePositions.insert(
+        index, _textDocument->findBlockByNumber(lineNumber - 1).position());
+  } else {
+    _lineNumbers.remove(index);
+    _linePositions.remove(index);
+  }
+  emit breakPointChanged(lineNumber, active);
+  return true;
+}
+
+void BreakPointStore::handleContentsChange(int position, int charsRemoved,
+                                           int charsAdded) {
+  const int blockCount = _textDocument->blockCount();
+  const int lineCountDifference = blockCount - _blockCount;
+  _blockCount = blockCount;
+  // Format changes are reported as the same range removed and added again,
+  // they move no text.
+  if (_lineNumbers.isEmpty() ||
+      (lineCountDifference == 0 && charsRemoved == charsAdded)) {
+    return;
+  }
+  // Lines starting before the edit keep their number and position.
+  const qsizetype first =
+      std::lower_bound(_linePositions.cbegin(), _linePositions.cend(),
+                       position) -
+      _linePositions.cbegin();
+  if (first == _linePositions.size()) {
+    return;
+  }
+  const int lastPosition = _textDocument->characterCount() - 1;
+  const int addedEnd = qMin(position + charsAdded, lastPosition);
+  const int removedEnd = position + charsRemoved;
+  // The removed text is gone, its line breaks follow from the added ones.
+  const int addedLineBreaks = _textDocument->findBlock(addedEnd).blockNumber() -
+                              _textDocument->findBlock(position).blockNumber();
+  const int removedLineBreaks = addedLineBreaks - lineCountDifference;
+
+  const QList<int> removedLineNumbers = _lineNumbers.sliced(first);
+  const QList<int> oldLinePositions = _linePositions.sliced(first);
+  _lineNumbers.resize(first);
+  _linePositions.resize(first);
+  for (qsizetype i = 0; i < removedLineNumbers.size(); ++i) {
+    const int oldPosition = oldLinePositions.at(i);
+    int newPosition;
+    if (oldPosition == position) {
+      // The edit starts at the beginning of the line. Inserted text moves the
+      // line down by the line breaks it adds, removing its line break as
+      // well deletes the whole line.
+      if (charsRemoved > 0 && removedLineBreaks > 0) {
+        continue;
+      }
+      newPosition = addedEnd;
+    } else if (oldPosition >= removedEnd) {
+      newPosition = oldPosition - charsRemoved + charsAdded;
+    } else {
+      // The line started inside the removed text.
+      continue;
+    }
+    const QTextBlock block =
+        _textDocument->findBlock(qMin(newPosition, lastPosition));
+    // A line whose preceding line break was the last removed character keeps
+    // its breakpoint only if whole lines were removed before it, otherwise it
+    // was joined into the edited line.
+    if (oldPosition == removedEnd && oldPosition > position &&
+        block.position() != newPosition) {
+      continue;
+    }
+    const int lineNumber = block.blockNumber() + 1;
+    if (_lineNumbers.isEmpty() || _lineNumbers.last() < lineNumber) {
+      _lineNumbers.append(lineNumber);
+      _linePositions.append(block.position());
+    }
+  }
+  const QList<int> addedLineNumbers = _lineNumbers.sliced(first);
+  for (const int lineNumber : removedLineNumbers) {
+    if (!std::binary_search(addedLineNumbers.cbegin(),
+                            addedLineNumbers.cend(), lineNumber)) {
+      emit breakPointChanged(lineNumber, false);
+    }
+  }
+  for (const int lineNumber : addedLineNumbers) {
+    if (!std::binary_search(removedLineNumbers.cbegin(),
+                            removedLineNumbers.cend(), lineNumber)) {
+      emit breakPointChanged(lineNumber, true);
+    }
+  }
+}
@@ -0,0 +1,184 @@
+#include <qtpreprocessorsupport.h>
+
+#include <QVariantMap>
+
+#include "callstackmodel.hpp"
+#include "virtualmachineservice.hpp"
+
+CallStackModel::CallStackModel(QObject* parent) : QAbstractListModel(parent) {}
+
+CallStackModel::~CallStackModel() {}
+
+int CallStackModel::rowCount(const QModelIndex& parent) const {
+  Q_UNUSED(parent)
+  return _frameCount;
+}
+
+QVariant CallStackModel::data(const QModelIndex& index, int role) const {
+  if (indexOutOfRange(index.row())) {
+    return QVariant();
+  }
+  switch (role) {
+    case FrameIndexRole:
+      return index.row();
+    case Qt::DisplayRole:
+    case FrameNameRole:
+      return frameNameAt(index.row());
+    case IsExpandedRole:
+      return isExpandedAt(index.row());
+    case FrameVariablesRole:
+      return frameVariablesAt(index.row());
+  }
+  return QVariant();
+}
+
+bool CallStackModel::setData(const QModelIndex& index, const QVariant& value,
+                             int role) {
+  switch (role) {
+    case IsExpandedRole:
+      return setExpandedAt(index.row(), value);
+  }
+  return false;
+}
+
+QHash<int, QByteArray> CallStackModel::roleNames() const {
+  return QHash<int, QByteArray>{
+      {Qt::DisplayRole, "display"},
+      {FrameIndexRole, "frameIndex"},
+      {FrameNameRole, "frameName"},
+      {IsExpandedRole, "isExpanded"},
+      {FrameVariablesRole, "frameVariables"},
+  };
+}
+
+VirtualMachineService* CallStackModel::virtualMachineService() const {
+  return _virtualMachineService.data();
+}
+
+void CallStackModel::setVirtualMachineService(
+    VirtualMachineService* virtualMachineService) {
+  if (_virtualMachineService != virtualMachineService) {
+    disconnectVirtualMachineService();
+    _virtualMachineService = QPointer(virtualMachineService);
+    emit virtualMachineServiceChanged();
+    connectVirtualMachineService();
+    updateCallStack();
+  }
+}
+
+bool CallStackModel::indexOutOfRange(int index) const {
+  return index < 0 || index >= _frameCount;
+}
+
+int CallStackModel::activationIndexAt(int index) const {
+  return _frameCount - index - 1;
+}
+
+QString CallStackModel::frameNameAt(int index) const {
+  const int activationIndex = activationIndexAt(index);
+  if (activationIndex == 0) {
+    return tr("Global");
+  }
+  return tr("Call %1").arg(activationIndex);
+}
+
+bool CallStackModel::isExpandedAt(int index) const {
+  return _expandedActivations.contains(activationIndexAt(index));
+}
+
+bool CallStackModel::setExpandedAt(int index, const QVariant& value) {
+  if (indexOutOfRange(index) || !value.isValid() ||
+      !value.canConvert<bool>()) {
+    return false;
+  }
+  const int activationIndex = activationIndexAt(index);
+  const bool expanded = value.toBool();
+  if (expanded == _expandedActivations.contains(activationIndex)) {
+    return true;
+  }
+  if (expanded) {
+    _expandedActivations.insert(activationIndex);
+  } else {
+    _expandedActivations.remove(activationIndex);
+    _materializedFrames.remove(activationIndex);
+  }
+  const QModelIndex modelIndex = createIndex(index, 0);
+  emit dataChanged(modelIndex, modelIndex,
+                   {IsExpandedRole, FrameVariablesRole});
+  return true;
+}
+
+QVariantList CallStackModel::frameVariablesAt(int index) const {
+  const int activationIndex = activationIndexAt(index);
+  if (_virtualMachineService.isNull() ||
+      !_expandedActivations.contains(activationIndex)) {
+    return QVariantList();
+  }
+  const auto materializedFrame = _materializedFrames.constFind(activationIndex);
+  if (materializedFrame != _materializedFrames.constEnd()) {
+    return materializedFrame.value();
+  }
+  QVariantList variables;
+  const auto frameVariables = _virtualMachineService->frameVariablesAt(index);
+  for (const auto& variable : frameVariables.asKeyValueRange()) {
+    variables.append(QVariantMap{{"name", variable.first},
+                                 {"value", variable.second}});
+  }
+  _materializedFrames.insert(activationIndex, variables);
+  return variables;
+}
+
+void CallStackModel::updateCallStack() {
+  const int frameCount = _virtualMachineService.isNull()
+                             ? 0
+                             : _virtualMachineService->callStackDepth();
+  resizeFrames(frameCount);
+  invalidateExpandedFrames();
+}
+
+void CallStackModel::resizeFrames(int frameCount) {
+  if (frameCount == _frameCount) {
+    return;
+  }
+  if (frameCount > _frameCount) {
+    beginInsertRows(QModelIndex(), 0, frameCount - _frameCount - 1);
+    _frameCount = frameCount;
+    endInsertRows();
+    return;
+  }
+  beginRemoveRows(QModelIndex(), 0, _frameCount - frameCount - 1);
+  _frameCount = frameCount;
+  for (auto iterator = _expandedActivations.begin();
+       iterator != _expandedActivations.end();) {
+    if (*iterator >= frameCount) {
+      iterator = _expandedActivations.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+  endRemoveRows();
+}
+
+void CallStackModel::invalidateExpandedFrames() {
+  _materializedFrames.clear();
+  for (const int activationIndex : _expandedActivations) {
+    const QModelIndex modelIndex =
+        createIndex(_frameCount - activationIndex - 1, 0);
+    emit dataChanged(modelIndex, modelIndex, {FrameVariablesRole});
+  }
+}
+
+void CallStackModel::connectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  connect(_virtualMachineService, &VirtualMachineService::callStackChanged,
+          this, &CallStackModel::updateCallStack);
+}
+
+void CallStackModel::disconnectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  disconnect(_virtualMachineService, nullptr, this, nullptr);
+}
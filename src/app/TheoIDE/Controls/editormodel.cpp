@@ -1,5 +1,6 @@
 #include <qtpreprocessorsupport.h>
 
+#include <QGuiApplication>
 #include <QTextBlock>
 #include <QtGlobal>
 #include <QtLogging>
@@ -7,11 +8,15 @@
 #include <chrono>
 #include <functional>
 #include <ranges>
+#include <utility>
 
 #include "editormodel.hpp"
+#include "executionsession.hpp"
 #include "executionstate.hpp"
 #include "virtualmachineservice.hpp"
 
+const int MODIFIED_CHECK_DELAY_MS = 300;
+
 EditorModel::EditorModel(QObject* parent) : QAbstractListModel(parent) {
   connect(this, &QAbstractListModel::rowsInserted, this,
           &EditorModel::updateMainTabIndex);
@@ -19,12 +24,31 @@ EditorModel::EditorModel(QObject* parent) : QAbstractListModel(parent) {
           &EditorModel::updateMainTabIndex);
   connect(this, &EditorModel::mainTabIndexChanged, this,
           &EditorModel::updateAllTabNames);
-  _executionStateTimer.setSingleShot(true);
-  _executionStateTimer.setInterval(std::chrono::seconds(5));
-  connect(&_executionStateTimer, &QTimer::timeout, this,
-          &EditorModel::stopExecution);
-  connect(this, &EditorModel::executionStateChanged, &_executionStateTimer,
-          &QTimer::stop);
+  connect(this, &EditorModel::mainTabIndexChanged, this,
+          &EditorModel::updateCurrentSession);
+  connect(this, &QAbstractListModel::rowsInserted, this,
+          &EditorModel::updateCurrentSession);
+  connect(this, &QAbstractListModel::rowsRemoved, this,
+          &EditorModel::updateCurrentSession);
+  connect(&_hibernationTimer, &QTimer::timeout, this,
+          &EditorModel::hibernateExpiredTabs);
+  // Mobile platforms reclaim memory from applications in the background
+  // first, so every tab that can be restored is hibernated when leaving the
+  // foreground.
+  if (qGuiApp != nullptr) {
+    connect(qGuiApp, &QGuiApplication::applicationStateChanged, this,
+            [this](Qt::ApplicationState state) -> void {
+              if (state == Qt::ApplicationHidden ||
+                  state == Qt::ApplicationSuspended) {
+                hibernateInactiveTabs();
+              }
+            });
+  }
+  _modifiedCheckTimer.setSingleShot(true);
+  _modifiedCheckTimer.setInterval(MODIFIED_CHECK_DELAY_MS);
+  connect(&_modifiedCheckTimer, &QTimer::timeout, this, [this]() -> void {
+    updateTabModified(_modifiedCheckTab.toStrongRef());
+  });
 }
 EditorModel::~EditorModel() {}
 
@@ -42,7 +66,10 @@ QHash<int, QByteArray> EditorModel::roleNames() const {
       {BackgroundCompilationTimerRole, "backgroundCompilationTimer"},
       {CursorPositionRole, "cursorPosition"},
       {CursorPositionEditRole, "cursorPositionEdit"},
-      {CursorLineNumberRole, "cursorLineNumber"}};
+      {CursorLineNumberRole, "cursorLineNumber"},
+      {ExecutionStateRole, "executionState"},
+      {LargeFileModelRole, "largeFileModel"},
+      {IsHibernatedRole, "isHibernated"}};
 }
 
 int EditorModel::rowCount(const QModelIndex& index) const {
@@ -69,13 +96,24 @@ QVariant EditorModel::data(const QModelIndex& index, int role) const {
       return cursorPositionAt(index.row());
     case CursorLineNumberRole:
       return cursorLineNumberAt(index.row());
+    case ExecutionStateRole:
+      return executionStateAt(index.row());
+    case LargeFileModelRole:
+      return QVariant::fromValue(largeFileModelAt(index.row()));
+    case IsHibernatedRole:
+      return isTabHibernatedAt(index.row());
   }
   return QVariant();
 }
 
 bool EditorModel::isTabReadOnlyAt(qsizetype index) const {
-  Q_UNUSED(index)
-  return _executionState != ExecutionState::Idle;
+  return executionStateAt(index) != ExecutionState::Idle;
+}
+
+bool EditorModel::isTabHibernatedAt(qsizetype index) const {
+  const TabModelOptional tab = tabAt(index);
+  return tab.has_value() && !tab.value().isNull() &&
+         tab.value()->isHibernated();
 }
 
 QString EditorModel::storedTabTextAt(qsizetype index) const {
@@ -86,6 +124,14 @@ QString EditorModel::storedTabTextAt(qsizetype index) const {
   return QString();
 }
 
+LargeFileModel* EditorModel::largeFileModelAt(qsizetype index) const {
+  const TabModelOptional tab = tabAt(index);
+  if (tab.has_value() && !tab.value().isNull()) {
+    return tab.value()->largeFileModel().data();
+  }
+  return nullptr;
+}
+
 QString EditorModel::tabNameAt(qsizetype index) const {
   const TabModelOptional tab = tabAt(index);
   if (tab.has_value() && !tab.value().isNull()) {
@@ -157,7 +203,18 @@ bool EditorModel::setTextDocumentVariantAt(qsizetype index,
   }
   const QPointer<QTextDocument> textDocument(quickTextDocument->textDocument());
   auto tab = tabOptional.value();
+  if (tab->textDocument() == textDocument) {
+    return true;
+  }
+  disconnectBreakPointStore(tab);
+  if (!tab->textDocument().isNull()) {
+    disconnect(tab->textDocument(), nullptr, this, nullptr);
+  }
   tab->setTextDocument(textDocument);
+  tab->releaseStoredText();
+  tab->restoreHibernatedState();
+  connectTextDocument(tab);
+  connectBreakPointStore(tab);
   return true;
 }
 
@@ -201,6 +258,8 @@ void EditorModel::connectFileSystemService() {
   if (_fileSystemService) {
     connect(_fileSystemService, &FileSystemService::fileRead, this,
             &EditorModel::createTabFromFile);
+    connect(_fileSystemService, &FileSystemService::largeFileRead, this,
+            &EditorModel::createLargeFileTab);
     connect(_fileSystemService, &FileSystemService::fileReadFailed, this,
             &EditorModel::displayFileReadFailure);
     connect(_fileSystemService,
@@ -232,6 +291,30 @@ void EditorModel::createTabFromFile(QSharedPointer<QFile> file,
   endInsertRows();
 }
 
+void EditorModel::createLargeFileTab(QSharedPointer<QFile> file,
+                                     QSharedPointer<PieceTable> pieceTable) {
+  QMutexLocker locker(&_tabsMutex);
+  const int index = _tabs.size();
+  beginInsertRows(QModelIndex(), index, index);
+  const QString tabName = createTabNameRelativeToMainTab(file);
+  auto tab = QSharedPointer<TabModel>(new TabModel(tabName, file, QString()));
+  auto largeFileModel =
+      QSharedPointer<LargeFileModel>(new LargeFileModel(pieceTable));
+  tab->setLargeFileModel(largeFileModel);
+  const QWeakPointer<TabModel> weakTab = tab;
+  connect(largeFileModel.data(), &LargeFileModel::isModifiedChanged, this,
+          [this, weakTab]() -> void {
+            const qsizetype index = _tabs.indexOf(weakTab.toStrongRef());
+            if (index >= 0) {
+              const QModelIndex modelIndex = createIndex(index, 0);
+              emit dataChanged(modelIndex, modelIndex,
+                               {IsModifiedRole, DisplayTabNameRole});
+            }
+          });
+  _tabs.append(tab);
+  endInsertRows();
+}
+
 void EditorModel::setDialogService(DialogService* dialogService) {
   if (_dialogService != dialogService) {
     _dialogService = QPointer(dialogService);
@@ -270,52 +353,79 @@ void EditorModel::createNewTab() {
   emit endInsertRows();
 }
 
-void EditorModel::runScript() {
-  setRunningMode(Default);
-  const bool compilationTaskPushed = tryPushCompilationTask();
-  if (!compilationTaskPushed) {
-    setExecutionState(ExecutionState::Idle);
+void EditorModel::runScript() { tryPushCompilationTask(Default); }
+
+void EditorModel::runScriptInDebugMode() { tryPushCompilationTask(Debug); }
+
+void EditorModel::replayRecording(const QUrl& url) {
+  tryPushCompilationTask(Debug, url.toLocalFile());
+}
+
+void EditorModel::stepOver() {
+  VirtualMachineService* const virtualMachineService = resumeCurrentSession();
+  if (virtualMachineService != nullptr) {
+    virtualMachineService->stepOver();
   }
 }
 
-void EditorModel::runScriptInDebugMode() {
-  setRunningMode(Debug);
-  const bool compilationTaskPushed = tryPushCompilationTask();
-  if (!compilationTaskPushed) {
-    setExecutionState(ExecutionState::Idle);
+void EditorModel::stepOut() {
+  VirtualMachineService* const virtualMachineService = resumeCurrentSession();
+  if (virtualMachineService != nullptr) {
+    virtualMachineService->stepOut();
   }
 }
 
-void EditorModel::stopExecution() {
-  if (_executionState == ExecutionState::Idle) {
-    return;
+void EditorModel::runToCursor() {
+  VirtualMachineService* const virtualMachineService = resumeCurrentSession();
+  if (virtualMachineService != nullptr) {
+    virtualMachineService->runToLine(tabNameAt(_currentTabIndex),
+                                     cursorLineNumberAt(_currentTabIndex));
   }
-  switch (_executionState) {
-    case ExecutionState::Compiling:
-      stopCompiler();
-      break;
-    case ExecutionState::Halt:
-    case ExecutionState::Executing:
-      stopVirtualMachine();
-      break;
-    default:
-      break;
+}
+
+VirtualMachineService* EditorModel::resumeCurrentSession() {
+  if (_currentSession.isNull() ||
+      _currentSession->executionState() != ExecutionState::Halt) {
+    return nullptr;
   }
+  _currentSession->setExecutionState(ExecutionState::Executing);
+  startExecutionStateTimer(_currentSession.data());
+  return _currentSession->virtualMachineService();
 }
 
-void EditorModel::stopVirtualMachine() {
-  if (_virtualMachineService.isNull()) {
+void EditorModel::applyChanges() {
+  if (_currentSession.isNull() || _compilerService.isNull() ||
+      _currentSession->runningMode() != Debug ||
+      _currentSession->executionState() != ExecutionState::Halt) {
+    return;
+  }
+  const auto task = currentCompilationTask();
+  if (!task) {
     return;
   }
-  _virtualMachineService->stopExecution();
+  _currentSession->setHotSwapPending(true);
+  _currentSession->setCurrentRunRevision(task->revision());
+  _currentSession->setCompilation(_compilerService->compile(*task));
 }
 
-void EditorModel::stopCompiler() {
-  if (_compilerService.isNull()) {
+void EditorModel::stopExecution() { stopSession(_currentSession.data()); }
+
+void EditorModel::stopSession(ExecutionSession* session) {
+  if (session == nullptr) {
     return;
   }
-  // TODO stop compilation
-  _compilerService->reset();
+  switch (session->executionState()) {
+    case ExecutionState::Compiling:
+      session->cancelCompilation();
+      session->setExecutionState(ExecutionState::Idle);
+      break;
+    case ExecutionState::Halt:
+    case ExecutionState::Executing:
+      session->virtualMachineService()->stopExecution();
+      break;
+    default:
+      break;
+  }
 }
 
 bool EditorModel::compilationPreconditionsFulfilled() const {
@@ -335,16 +445,30 @@ bool EditorModel::compilationPreconditionsFulfilled() const {
   return true;
 }
 
-bool EditorModel::tryPushCompilationTask() {
+bool EditorModel::tryPushCompilationTask(RunningMode runningMode,
+                                         const QString& replayLogPath) {
   if (!compilationPreconditionsFulfilled()) {
     return false;
   }
   try {
     const CompilationTask task = createCompilationTaskFromTabContent();
-    _currentRunRevision = task.revision();
-    setExecutionState(ExecutionState::Compiling);
-    startExecutionStateTimer();
-    _compilerService->compile(task);
+    const TabModelOptional tab = mainTab();
+    if (!tab.has_value() || tab.value().isNull()) {
+      throw MainTabInvalidStateError();
+    }
+    QSharedPointer<ExecutionSession> session = sessionOf(tab.value());
+    if (session.isNull()) {
+      session = createSessionFor(tab.value());
+    }
+    if (session->executionState() != ExecutionState::Idle) {
+      return false;
+    }
+    session->setRunningMode(runningMode);
+    session->setReplayLogPath(replayLogPath);
+    session->setCurrentRunRevision(task.revision());
+    session->setExecutionState(ExecutionState::Compiling);
+    startExecutionStateTimer(session.data());
+    session->setCompilation(_compilerService->compile(task));
   } catch (const NoMainTabError& error) {
     if (_dialogService) {
       _dialogService->addNoMainScriptSelected();
@@ -387,6 +511,24 @@ CompilationTask EditorModel::createCompilationTaskFromTabContent() const {
     if (isMainTabIndex(tabIndex)) {
       mainTabName = tab->name();
     }
+    if (tab->isLargeFile()) {
+      const QString tabContent = tab->largeFileModel()->text();
+      if (isMainTabIndex(tabIndex) && tabContent.isEmpty()) {
+        throw EmptyMainTabError();
+      }
+      revision += tab->largeFileModel()->revision();
+      content.insert(tab->name(), tabContent);
+      continue;
+    }
+    if (tab->isHibernated()) {
+      const QString tabContent = tab->hibernatedContent();
+      if (isMainTabIndex(tabIndex) && tabContent.isEmpty()) {
+        throw EmptyMainTabError();
+      }
+      revision += tab->revision();
+      content.insert(tab->name(), tabContent);
+      continue;
+    }
     auto tabTextDocument = tab->textDocument();
     if (tabTextDocument.isNull()) {
       if (isMainTabIndex(tabIndex)) {
@@ -398,7 +540,7 @@ CompilationTask EditorModel::createCompilationTaskFromTabContent() const {
     if (isMainTabIndex(tabIndex) && tabContent.isEmpty()) {
       throw EmptyMainTabError();
     }
-    revision += tabTextDocument->revision();
+    revision += tab->revision();
     content.insert(tab->name(), tabContent);
   }
   if (mainTabName.isEmpty()) {
@@ -407,6 +549,18 @@ CompilationTask EditorModel::createCompilationTaskFromTabContent() const {
   return CompilationTask(revision, content, mainTabName);
 }
 
+std::optional<CompilationTask> EditorModel::currentCompilationTask() const {
+  if (_tabs.isEmpty()) {
+    return std::nullopt;
+  }
+  try {
+    return createCompilationTaskFromTabContent();
+  } catch (const std::runtime_error& error) {
+    qWarning() << "Unable to create compilation task:" << error.what();
+    return std::nullopt;
+  }
+}
+
 void EditorModel::closeTabAt(qsizetype index) {
   QMutexLocker locker(&_tabsMutex);
   TabModelOptional tab = tabAt(index);
@@ -420,7 +574,9 @@ void EditorModel::closeTabAt(qsizetype index) {
                                                tabModel]() -> void {
     beginRemoveRows(QModelIndex(), index, index);
     _tabs.removeAt(index);
+    disconnectBreakPointStore(tabModel);
     removeTemporaryTabIndex(tabModel);
+    removeSessionOf(tabModel);
     endRemoveRows();
   };
   if (!tabModel->isModified()) {
@@ -521,7 +677,14 @@ void EditorModel::updateTabNameAt(qsizetype index) {
   if (newTabName == tab->name()) {
     return;
   }
+  const QList<int> lineNumbers = tab->breakPointLineNumbers();
+  for (const int lineNumber : lineNumbers) {
+    applyBreakPointAt(tab->name(), lineNumber, false);
+  }
   tab->setName(newTabName);
+  for (const int lineNumber : lineNumbers) {
+    applyBreakPointAt(newTabName, lineNumber, true);
+  }
   const QModelIndex modelIndex = createIndex(index, 0);
   emit dataChanged(modelIndex, modelIndex);
 }
@@ -614,7 +777,12 @@ void EditorModel::updateMainTabIndex() {
 
 void EditorModel::setCurrentTabIndex(int currentTabIndex) {
   if (_currentTabIndex != currentTabIndex) {
+    const TabModelOptional previousTab = tabAt(_currentTabIndex);
+    if (previousTab.has_value() && !previousTab.value().isNull()) {
+      previousTab.value()->markInactive();
+    }
     _currentTabIndex = currentTabIndex;
+    wakeTabAt(currentTabIndex);
     emit currentTabIndexChanged(currentTabIndex);
   }
 }
@@ -625,8 +793,8 @@ void EditorModel::connectCompilerService() {
   if (_compilerService.isNull()) {
     return;
   }
-  connect(_compilerService, &CompilerService::atLeastRevisionAvailable, this,
-          &EditorModel::handleCompilationRevisionAvailable);
+  connect(_compilerService, &CompilerService::compilationResultAvailable, this,
+          &EditorModel::handleCompilationResultAvailable);
   connect(this, &EditorModel::rowsInserted, _compilerService,
           &CompilerService::reset);
   connect(this, &EditorModel::rowsRemoved, _compilerService,
@@ -643,31 +811,28 @@ void EditorModel::disconnectCompilerService() {
   disconnect(this, nullptr, _compilerService, nullptr);
 }
 
-QSharedPointer<CompilationResult> EditorModel::latestCompilationResult() const {
-  if (_compilerService.isNull()) {
-    qCritical() << "Tried to get the latest compilation result, but the "
-                   "compiler service is null";
-    return nullptr;
-  }
-  const auto result = _compilerService->result();
-  if (result.isNull()) {
+void EditorModel::handleCompilationResultAvailable(
+    QSharedPointer<CompilationResult> compilationResult) {
+  if (compilationResult.isNull()) {
     qCritical() << "Compiler service has provided a null reference to result.";
+    return;
   }
-  return result;
-}
-
-void EditorModel::handleCompilationRevisionAvailable(int revision) {
-  if (revision < _currentRunRevision) {
+  const auto session =
+      sessionOfMainTabName(compilationResult->mainTabName());
+  if (session.isNull() ||
+      compilationResult->revision() < session->currentRunRevision()) {
     return;
   }
-  const auto compilationResult = latestCompilationResult();
-  if (compilationResult.isNull()) {
-    setExecutionState(ExecutionState::Idle);
+  if (session->isHotSwapPending()) {
+    hotSwapSession(session.data(), compilationResult);
+    return;
+  }
+  if (session->executionState() != ExecutionState::Compiling) {
     return;
   }
   const Theo::CodegenResult result = compilationResult->result();
   if (!result.generated_correctly) {
-    setExecutionState(ExecutionState::Idle);
+    session->setExecutionState(ExecutionState::Idle);
     if (_dialogService.isNull()) {
       qCritical() << "Tried to inform the user that the compilation failed, "
                      "but the dialog service is null";
@@ -676,23 +841,67 @@ void EditorModel::handleCompilationRevisionAvailable(int revision) {
     _dialogService->addCompilationFailed(result);
     return;
   }
-  startVirtualMachine(result.code);
+  startVirtualMachine(session.data(), compilationResult);
 }
 
-void EditorModel::startVirtualMachine(const Theo::Program& program) {
-  if (_virtualMachineService.isNull()) {
-    setExecutionState(ExecutionState::Idle);
-    qCritical() << "Tried to start vm, but virtual machine service is null";
+void EditorModel::hotSwapSession(
+    ExecutionSession* session,
+    QSharedPointer<CompilationResult> compilationResult) {
+  session->setHotSwapPending(false);
+  if (session->executionState() != ExecutionState::Halt) {
+    return;
+  }
+  const Theo::CodegenResult result = compilationResult->result();
+  if (!result.generated_correctly) {
+    if (_dialogService.isNull()) {
+      qCritical() << "Tried to inform the user that the compilation failed, "
+                     "but the dialog service is null";
+      return;
+    }
+    _dialogService->addCompilationFailed(result);
+    return;
+  }
+  session->setExecutionState(ExecutionState::Executing);
+  startExecutionStateTimer(session);
+  VirtualMachineService* const virtualMachineService =
+      session->virtualMachineService();
+  if (virtualMachineService->isRunningIsolated()) {
+    virtualMachineService->hotSwapIsolated(compilationResult->task());
     return;
   }
-  setExecutionState(ExecutionState::Executing);
-  startExecutionStateTimer();
-  switch (_runningMode) {
+  virtualMachineService->hotSwap(result.code, compilationResult->programHash());
+}
+
+void EditorModel::startVirtualMachine(
+    ExecutionSession* session,
+    QSharedPointer<CompilationResult> compilationResult) {
+  VirtualMachineService* const virtualMachineService =
+      session->virtualMachineService();
+  const Theo::CodegenResult result = compilationResult->result();
+  const QByteArray programHash = compilationResult->programHash();
+  const bool isolated = virtualMachineService->isolatedExecutionEnabled();
+  session->setExecutionState(ExecutionState::Executing);
+  startExecutionStateTimer(session);
+  const QString replayLogPath = session->replayLogPath();
+  session->setReplayLogPath(QString());
+  switch (session->runningMode()) {
     case Debug:
-      _virtualMachineService->debug(program);
+      if (!replayLogPath.isEmpty()) {
+        virtualMachineService->replay(result.code, programHash, replayLogPath);
+        return;
+      }
+      if (isolated) {
+        virtualMachineService->debugIsolated(compilationResult->task());
+        return;
+      }
+      virtualMachineService->debug(result.code, programHash);
       return;
     case Default:
-      _virtualMachineService->execute(program);
+      if (isolated) {
+        virtualMachineService->executeIsolated(compilationResult->task());
+        return;
+      }
+      virtualMachineService->execute(result.code, programHash);
       return;
     default:
       return;
@@ -710,6 +919,7 @@ void EditorModel::setVirtualMachineService(
     _virtualMachineService = QPointer(virtualMachineService);
     emit virtualMachineServiceChanged();
     connectVirtualMachineService();
+    updateSessionSettings();
   }
 }
 
@@ -717,16 +927,324 @@ void EditorModel::connectVirtualMachineService() {
   if (_virtualMachineService.isNull()) {
     return;
   }
-  connect(_virtualMachineService, &VirtualMachineService::variablesStateChanged,
-          this, &EditorModel::handleVirtualMachineVariableStateChanged);
   connect(_virtualMachineService,
-          &VirtualMachineService::executionFailedForInternalReason, this,
-          &EditorModel::displayExecutionFailedForInternalReason);
+          &VirtualMachineService::liveVariablesEnabledChanged, this,
+          &EditorModel::updateSessionSettings);
+  connect(_virtualMachineService,
+          &VirtualMachineService::liveVariablesMaxRateHzChanged, this,
+          &EditorModel::updateSessionSettings);
+  connect(_virtualMachineService,
+          &VirtualMachineService::executionCacheEnabledChanged, this,
+          &EditorModel::updateSessionSettings);
+  connect(_virtualMachineService,
+          &VirtualMachineService::memoryLimitBytesChanged, this,
+          &EditorModel::updateSessionSettings);
   connect(_virtualMachineService,
+          &VirtualMachineService::recordingDirectoryChanged, this,
+          &EditorModel::updateSessionSettings);
+  connect(_virtualMachineService,
+          &VirtualMachineService::isolatedExecutionEnabledChanged, this,
+          &EditorModel::updateSessionSettings);
+}
+
+void EditorModel::applyVirtualMachineSettings(
+    VirtualMachineService* service) const {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  service->setLiveVariablesEnabled(
+      _virtualMachineService->liveVariablesEnabled());
+  service->setLiveVariablesMaxRateHz(
+      _virtualMachineService->liveVariablesMaxRateHz());
+  service->setExecutionCacheEnabled(
+      _virtualMachineService->executionCacheEnabled());
+  service->setMemoryLimitBytes(_virtualMachineService->memoryLimitBytes());
+  service->setRecordingDirectory(_virtualMachineService->recordingDirectory());
+  service->setIsolatedExecutionEnabled(
+      _virtualMachineService->isolatedExecutionEnabled());
+}
+
+void EditorModel::updateSessionSettings() {
+  for (const auto& session : std::as_const(_sessions)) {
+    applyVirtualMachineSettings(session->virtualMachineService());
+  }
+}
+
+QSharedPointer<ExecutionSession> EditorModel::sessionOf(
+    QSharedPointer<TabModel> tab) const {
+  return _sessions.value(tab);
+}
+
+QSharedPointer<ExecutionSession> EditorModel::sessionAt(qsizetype index) const {
+  const TabModelOptional tab = tabAt(index);
+  if (!tab.has_value() || tab.value().isNull()) {
+    return nullptr;
+  }
+  return sessionOf(tab.value());
+}
+
+QSharedPointer<ExecutionSession> EditorModel::sessionOfMainTabName(
+    const QString& mainTabName) const {
+  for (const auto& session : _sessions.asKeyValueRange()) {
+    if (session.first->name() == mainTabName) {
+      return session.second;
+    }
+  }
+  return nullptr;
+}
+
+QSharedPointer<ExecutionSession> EditorModel::createSessionFor(
+    QSharedPointer<TabModel> tab) {
+  auto session = QSharedPointer<ExecutionSession>(new ExecutionSession());
+  applyVirtualMachineSettings(session->virtualMachineService());
+  applyBreakPoints(session->virtualMachineService());
+  _sessions.insert(tab, session);
+  connectSession(tab, session);
+  updateCurrentSession();
+  return session;
+}
+
+void EditorModel::connectSession(QSharedPointer<TabModel> tab,
+                                 QSharedPointer<ExecutionSession> session) {
+  ExecutionSession* const sessionPointer = session.data();
+  VirtualMachineService* const virtualMachineService =
+      session->virtualMachineService();
+  const QWeakPointer<TabModel> weakTab = tab;
+  connect(sessionPointer, &ExecutionSession::executionStateChanged, this,
+          [this, weakTab]() -> void {
+            handleSessionExecutionStateChanged(weakTab.toStrongRef());
+          });
+  connect(sessionPointer, &ExecutionSession::runningModeChanged, this,
+          [this, sessionPointer]() -> void {
+            if (_currentSession == sessionPointer) {
+              emit runningModeChanged(sessionPointer->runningMode());
+            }
+          });
+  connect(sessionPointer, &ExecutionSession::executionStateTimedOut, this,
+          [this, sessionPointer]() -> void { stopSession(sessionPointer); });
+  connect(virtualMachineService, &VirtualMachineService::executionHalted, this,
+          [this, sessionPointer]() -> void {
+            handleExecutionHalted(sessionPointer);
+          });
+  connect(virtualMachineService,
           &VirtualMachineService::executionFailedForInternalReason, this,
-          &EditorModel::handleExecutionCompleted);
-  connect(_virtualMachineService, &VirtualMachineService::executionCompleted,
-          this, &EditorModel::handleExecutionCompleted);
+          &EditorModel::displayExecutionFailedForInternalReason);
+  connect(virtualMachineService, &VirtualMachineService::memoryLimitExceeded,
+          this, &EditorModel::displayMemoryLimitExceeded);
+  connect(virtualMachineService, &VirtualMachineService::hotSwapCompleted,
+          this, &EditorModel::displayHotSwapCompleted);
+  connect(virtualMachineService, &VirtualMachineService::replayFailed, this,
+          &EditorModel::displayReplayFailed);
+  const std::function<void(void)> completeExecution =
+      [sessionPointer]() -> void {
+    qInfo() << "Execution completed";
+    sessionPointer->setExecutionState(ExecutionState::Idle);
+  };
+  connect(virtualMachineService,
+          &VirtualMachineService::executionFailedForInternalReason,
+          sessionPointer, completeExecution);
+  connect(virtualMachineService, &VirtualMachineService::executionCompleted,
+          sessionPointer, completeExecution);
+}
+
+void EditorModel::connectTextDocument(QSharedPointer<TabModel> tab) {
+  const QPointer<QTextDocument> textDocument = tab->textDocument();
+  if (textDocument.isNull()) {
+    return;
+  }
+  const QWeakPointer<TabModel> weakTab = tab;
+  connect(textDocument, &QTextDocument::modificationChanged, this,
+          [this, weakTab]() -> void {
+            updateTabModified(weakTab.toStrongRef());
+          });
+  connect(textDocument, &QTextDocument::contentsChanged, this,
+          [this, weakTab]() -> void {
+            scheduleTabModifiedUpdate(weakTab.toStrongRef());
+          });
+  updateTabModified(tab);
+}
+
+void EditorModel::updateTabModified(QSharedPointer<TabModel> tab) {
+  if (!tab.isNull() && tab->updateModified()) {
+    emitTabModifiedChanged(tab);
+  }
+}
+
+// The tab counts as modified right away, the comparison with the saved
+// content waits until typing pauses.
+void EditorModel::scheduleTabModifiedUpdate(QSharedPointer<TabModel> tab) {
+  if (tab.isNull()) {
+    return;
+  }
+  if (tab->markContentChanged()) {
+    emitTabModifiedChanged(tab);
+  }
+  const QSharedPointer<TabModel> pendingTab = _modifiedCheckTab.toStrongRef();
+  if (pendingTab != tab) {
+    updateTabModified(pendingTab);
+    _modifiedCheckTab = tab;
+  }
+  _modifiedCheckTimer.start();
+}
+
+void EditorModel::emitTabModifiedChanged(QSharedPointer<TabModel> tab) {
+  const qsizetype index = _tabs.indexOf(tab);
+  if (index >= 0) {
+    const QModelIndex modelIndex = createIndex(index, 0);
+    emit dataChanged(modelIndex, modelIndex,
+                     {IsModifiedRole, DisplayTabNameRole});
+  }
+}
+
+void EditorModel::connectBreakPointStore(QSharedPointer<TabModel> tab) {
+  BreakPointStore* const breakPointStore = tab->breakPointStore();
+  if (breakPointStore == nullptr) {
+    return;
+  }
+  const QWeakPointer<TabModel> weakTab = tab;
+  connect(breakPointStore, &BreakPointStore::breakPointChanged, this,
+          [this, weakTab](int lineNumber, bool active) -> void {
+            const auto tab = weakTab.toStrongRef();
+            if (!tab.isNull()) {
+              applyBreakPointAt(tab->name(), lineNumber, active);
+            }
+          });
+  for (const int lineNumber : breakPointStore->lineNumbers()) {
+    applyBreakPointAt(tab->name(), lineNumber, true);
+  }
+}
+
+void EditorModel::disconnectBreakPointStore(QSharedPointer<TabModel> tab) {
+  BreakPointStore* const breakPointStore = tab->breakPointStore();
+  if (breakPointStore != nullptr) {
+    disconnect(breakPointStore, nullptr, this, nullptr);
+  }
+  for (const int lineNumber : tab->breakPointLineNumbers()) {
+    applyBreakPointAt(tab->name(), lineNumber, false);
+  }
+}
+
+void EditorModel::applyBreakPointAt(const QString& tabName, int lineNumber,
+                                    bool active) const {
+  for (const auto& session : std::as_const(_sessions)) {
+    VirtualMachineService* const service = session->virtualMachineService();
+    if (active) {
+      service->setBreakPointAt(tabName, lineNumber);
+    } else {
+      service->deleteBreakPointAt(tabName, lineNumber);
+    }
+  }
+}
+
+void EditorModel::applyBreakPoints(VirtualMachineService* service) const {
+  for (const auto& tab : _tabs) {
+    for (const int lineNumber : tab->breakPointLineNumbers()) {
+      service->setBreakPointAt(tab->name(), lineNumber);
+    }
+  }
+}
+
+bool EditorModel::canHibernateTabAt(qsizetype index) const {
+  const TabModelOptional tabOptional = tabAt(index);
+  if (!tabOptional.has_value() || tabOptional.value().isNull()) {
+    return false;
+  }
+  const auto tab = tabOptional.value();
+  return index != _currentTabIndex && !tab->isHibernated() &&
+         !tab->isLargeFile() && !tab->textDocument().isNull() &&
+         executionStateAt(index) == ExecutionState::Idle;
+}
+
+// Expects _tabsMutex to be held by the caller.
+void EditorModel::hibernateTabAt(qsizetype index) {
+  if (!canHibernateTabAt(index)) {
+    return;
+  }
+  const auto tab = tabAt(index).value();
+  BreakPointStore* const breakPointStore = tab->breakPointStore();
+  if (breakPointStore != nullptr) {
+    disconnect(breakPointStore, nullptr, this, nullptr);
+  }
+  disconnect(tab->textDocument(), nullptr, this, nullptr);
+  tab->hibernate();
+  const QModelIndex modelIndex = createIndex(index, 0);
+  emit dataChanged(modelIndex, modelIndex,
+                   {IsHibernatedRole, TextDocumentRole});
+}
+
+void EditorModel::wakeTabAt(qsizetype index) {
+  const TabModelOptional tabOptional = tabAt(index);
+  if (!tabOptional.has_value() || tabOptional.value().isNull() ||
+      !tabOptional.value()->isHibernated()) {
+    return;
+  }
+  tabOptional.value()->wake();
+  const QModelIndex modelIndex = createIndex(index, 0);
+  emit dataChanged(modelIndex, modelIndex,
+                   {IsHibernatedRole, StoredTabTextRole});
+}
+
+void EditorModel::hibernateInactiveTabs() {
+  QMutexLocker locker(&_tabsMutex);
+  for (qsizetype index = 0; index < _tabs.size(); ++index) {
+    hibernateTabAt(index);
+  }
+}
+
+void EditorModel::hibernateExpiredTabs() {
+  QMutexLocker locker(&_tabsMutex);
+  for (qsizetype index = 0; index < _tabs.size(); ++index) {
+    if (!_tabs.at(index).isNull() &&
+        _tabs.at(index)->inactiveMs() >= _hibernationTimeoutMs) {
+      hibernateTabAt(index);
+    }
+  }
+}
+
+void EditorModel::removeSessionOf(QSharedPointer<TabModel> tab) {
+  const QSharedPointer<ExecutionSession> session = _sessions.take(tab);
+  if (session.isNull()) {
+    return;
+  }
+  disconnect(session.data(), nullptr, this, nullptr);
+  disconnect(session->virtualMachineService(), nullptr, this, nullptr);
+  session->virtualMachineService()->stopExecution();
+}
+
+void EditorModel::handleSessionExecutionStateChanged(
+    QSharedPointer<TabModel> tab) {
+  const qsizetype index = _tabs.indexOf(tab);
+  if (index >= 0) {
+    const QModelIndex modelIndex = createIndex(index, 0);
+    emit dataChanged(modelIndex, modelIndex,
+                     {IsReadOnlyRole, ExecutionStateRole});
+  }
+  if (!_currentSession.isNull() && _currentSession == sessionOf(tab).data()) {
+    emit executionStateChanged();
+  }
+}
+
+void EditorModel::updateCurrentSession() {
+  ExecutionSession* const session = sessionAt(_mainTabIndex).data();
+  if (_currentSession == session) {
+    return;
+  }
+  _currentSession = QPointer(session);
+  emit currentSessionChanged();
+  emit executionStateChanged();
+  emit runningModeChanged(runningMode());
+}
+
+ExecutionSession* EditorModel::currentSession() const {
+  return _currentSession.data();
+}
+
+ExecutionState EditorModel::executionStateAt(qsizetype index) const {
+  const auto session = sessionAt(index);
+  if (session.isNull()) {
+    return ExecutionState::Idle;
+  }
+  return session->executionState();
 }
 
 void EditorModel::displayExecutionFailedForInternalReason() {
@@ -739,27 +1257,50 @@ void EditorModel::displayExecutionFailedForInternalReason() {
   _dialogService->addExecutionFailedForInternalReason();
 }
 
-void EditorModel::disconnectVirtualMachineService() {
-  if (_virtualMachineService.isNull()) {
+void EditorModel::displayMemoryLimitExceeded(qint64 memoryLimitBytes) {
+  if (_dialogService.isNull()) {
+    qCritical() << "Tried to inform the user that the memory limit was "
+                   "exceeded, but the dialog service is null";
     return;
   }
-  disconnect(_virtualMachineService, nullptr, this, nullptr);
+  _dialogService->addMemoryLimitExceeded(memoryLimitBytes);
 }
 
-void EditorModel::handleExecutionCompleted() {
-  qInfo() << "Execution completed";
-  setExecutionState(ExecutionState::Idle);
+void EditorModel::displayHotSwapCompleted(
+    bool resumed, const QStringList& changedVariables) {
+  if (resumed && changedVariables.isEmpty()) {
+    qInfo() << "Changes applied without affecting the halted state";
+    return;
+  }
+  if (_dialogService.isNull()) {
+    qCritical() << "Tried to inform the user about the applied changes, but "
+                   "the dialog service is null";
+    return;
+  }
+  _dialogService->addHotSwapCompleted(resumed, changedVariables);
 }
 
-void EditorModel::setRunningMode(RunningMode runningMode) {
-  if (_runningMode != runningMode) {
-    _runningMode = runningMode;
-    emit runningModeChanged(runningMode);
+void EditorModel::displayReplayFailed(const QString& reason) {
+  if (_dialogService.isNull()) {
+    qCritical() << "Tried to inform the user that the replay failed, but the "
+                   "dialog service is null";
+    return;
+  }
+  _dialogService->addReplayFailed(reason);
+}
+
+void EditorModel::disconnectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
   }
+  disconnect(_virtualMachineService, nullptr, this, nullptr);
 }
 
 EditorModel::RunningMode EditorModel::runningMode() const {
-  return _runningMode;
+  if (_currentSession.isNull()) {
+    return Default;
+  }
+  return _currentSession->runningMode();
 }
 
 int EditorModel::cursorPositionAt(int index) const {
@@ -796,7 +1337,8 @@ bool EditorModel::setCursorPositionAt(int index, int position) {
     return false;
   }
   auto tab = tabOptional.value();
-  if (tab->cursorPosition() == position || position < 0) {
+  if (tab->cursorPosition() == position || position < 0 ||
+      tab->isHibernated()) {
     return false;
   }
   if (tab->textDocument().isNull() || tab->textDocument()->isEmpty()) {
@@ -900,19 +1442,17 @@ bool EditorModel::setLineNumberAt(int index, int lineNumber) {
   return true;
 }
 
-void EditorModel::startExecutionStateTimer() {
-  switch (_executionState) {
+void EditorModel::startExecutionStateTimer(ExecutionSession* session) {
+  switch (session->executionState()) {
     case ExecutionState::Compiling:
-      _executionStateTimer.setInterval(_compilationTimeoutMs);
+      session->startExecutionStateTimer(_compilationTimeoutMs);
       break;
     case ExecutionState::Executing:
-      _executionStateTimer.setInterval(_executionTimeoutMs);
+      session->startExecutionStateTimer(_executionTimeoutMs);
       break;
     default:
       return;
   }
-  _executionStateTimer.setSingleShot(true);
-  _executionStateTimer.start();
 }
 
 int EditorModel::executionTimeoutMs() const { return _executionTimeoutMs; }
@@ -933,17 +1473,29 @@ void EditorModel::setCompilationTimeoutMs(int value) {
   }
 }
 
-void EditorModel::setExecutionState(ExecutionState executionState) {
-  if (_executionState != executionState) {
-    _executionState = executionState;
-    emit executionStateChanged();
+int EditorModel::hibernationTimeoutMs() const { return _hibernationTimeoutMs; }
+
+void EditorModel::setHibernationTimeoutMs(int value) {
+  if (_hibernationTimeoutMs != value) {
+    _hibernationTimeoutMs = value;
+    if (value > 0) {
+      _hibernationTimer.start(std::clamp(value / 4, 1000, 60000));
+    } else {
+      _hibernationTimer.stop();
+    }
+    emit hibernationTimeoutMsChanged();
   }
 }
 
-void EditorModel::handleVirtualMachineVariableStateChanged() {
-  if (_executionState == ExecutionState::Executing) {
-    setExecutionState(ExecutionState::Halt);
+void EditorModel::handleExecutionHalted(ExecutionSession* session) {
+  if (session->executionState() == ExecutionState::Executing) {
+    session->setExecutionState(ExecutionState::Halt);
   }
 }
 
-ExecutionState EditorModel::executionState() const { return _executionState; }
+ExecutionState EditorModel::executionState() const {
+  if (_currentSession.isNull()) {
+    return ExecutionState::Idle;
+  }
+  return _currentSession->executionState();
+}
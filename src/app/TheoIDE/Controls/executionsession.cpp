@@ -0,0 +1,72 @@
+#include "executionsession.hpp"
+
+ExecutionSession::ExecutionSession(QObject* parent)
+    : QObject(parent), _virtualMachineService(new VirtualMachineService(this)) {
+  _executionStateTimer.setSingleShot(true);
+  connect(&_executionStateTimer, &QTimer::timeout, this,
+          &ExecutionSession::executionStateTimedOut);
+  connect(this, &ExecutionSession::executionStateChanged,
+          &_executionStateTimer, &QTimer::stop);
+}
+
+ExecutionSession::~ExecutionSession() {}
+
+VirtualMachineService* ExecutionSession::virtualMachineService() const {
+  return _virtualMachineService;
+}
+
+ExecutionState ExecutionSession::executionState() const {
+  return _executionState;
+}
+
+void ExecutionSession::setExecutionState(ExecutionState executionState) {
+  if (_executionState != executionState) {
+    _executionState = executionState;
+    emit executionStateChanged();
+  }
+}
+
+EditorModel::RunningMode ExecutionSession::runningMode() const {
+  return _runningMode;
+}
+
+void ExecutionSession::setRunningMode(EditorModel::RunningMode runningMode) {
+  if (_runningMode != runningMode) {
+    _runningMode = runningMode;
+    emit runningModeChanged();
+  }
+}
+
+long long ExecutionSession::currentRunRevision() const {
+  return _currentRunRevision;
+}
+
+void ExecutionSession::setCurrentRunRevision(long long revision) {
+  _currentRunRevision = revision;
+}
+
+bool ExecutionSession::isHotSwapPending() const { return _hotSwapPending; }
+
+void ExecutionSession::setHotSwapPending(bool hotSwapPending) {
+  _hotSwapPending = hotSwapPending;
+}
+
+QString ExecutionSession::replayLogPath() const { return _replayLogPath; }
+
+void ExecutionSession::setReplayLogPath(const QString& replayLogPath) {
+  _replayLogPath = replayLogPath;
+}
+
+void ExecutionSession::startExecutionStateTimer(int timeoutMs) {
+  _executionStateTimer.setInterval(timeoutMs);
+  _executionStateTimer.start();
+}
+
+void ExecutionSession::setCompilation(const QFuture<void>& compilation) {
+  _compilation = compilation;
+}
+
+void ExecutionSession::cancelCompilation() {
+  _compilation.cancel();
+  _compilation = QFuture<void>();
+}
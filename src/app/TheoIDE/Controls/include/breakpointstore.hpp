@@ -0,0 +1,38 @@
+#ifndef _THEOIDE_CONTROLS_BREAKPOINTSTORE_
+#define _THEOIDE_CONTROLS_BREAKPOINTSTORE_
+
+#include <QList>
+#include <QObject>
+#include <QTextDocument>
+
+// Breakpoints of one document, kept as a sorted list of line numbers that is
+// shifted along with the text when lines are inserted or removed. The start
+// position of each line is kept next to it, so an edit can tell whether a
+// line was removed as a whole or only lost its line break. The store is owned
+// by the document so every view of it shares the same breakpoints.
+class BreakPointStore : public QObject {
+  Q_OBJECT
+ public:
+  static BreakPointStore* of(QTextDocument* textDocument);
+  ~BreakPointStore();
+
+  const QList<int>& lineNumbers() const;
+  bool contains(int lineNumber) const;
+  bool setBreakPoint(int lineNumber, bool active);
+
+ signals:
+  void breakPointChanged(int lineNumber, bool active);
+
+ protected slots:
+  void handleContentsChange(int position, int charsRemoved, int charsAdded);
+
+ private:
+  BreakPointStore(QTextDocument* textDocument);
+
+  QTextDocument* _textDocument;
+  QList<int> _lineNumbers;
+  QList<int> _linePositions;
+  int _blockCount;
+};
+
+#endif
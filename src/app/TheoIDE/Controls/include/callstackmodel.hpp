@@ -0,0 +1,67 @@
+#ifndef _THEOIDE_CONTROLS_CALLSTACKMODEL_
+#define _THEOIDE_CONTROLS_CALLSTACKMODEL_
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QVariant>
+#include <QVariantList>
+#include <QtQmlIntegration>
+
+#include "virtualmachineservice.hpp"
+
+class CallStackModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(
+      VirtualMachineService* virtualMachineService READ virtualMachineService
+          WRITE setVirtualMachineService NOTIFY virtualMachineServiceChanged)
+  QML_ELEMENT
+ public:
+  CallStackModel(QObject* parent = nullptr);
+  ~CallStackModel();
+  enum CallStackModelRole {
+    FrameIndexRole = Qt::UserRole + 1,
+    FrameNameRole,
+    IsExpandedRole,
+    FrameVariablesRole,
+  };
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  bool setData(const QModelIndex& index, const QVariant& value,
+               int role = Qt::EditRole) override;
+  QHash<int, QByteArray> roleNames() const override;
+  VirtualMachineService* virtualMachineService() const;
+
+ public slots:
+  void setVirtualMachineService(VirtualMachineService* virtualMachineService);
+
+ signals:
+  void virtualMachineServiceChanged();
+
+ protected slots:
+  void updateCallStack();
+
+ private:
+  QPointer<VirtualMachineService> _virtualMachineService;
+  int _frameCount = 0;
+  QSet<int> _expandedActivations;
+  mutable QMap<int, QVariantList> _materializedFrames;
+
+  bool indexOutOfRange(int index) const;
+  int activationIndexAt(int index) const;
+  QString frameNameAt(int index) const;
+  bool isExpandedAt(int index) const;
+  bool setExpandedAt(int index, const QVariant& value);
+  QVariantList frameVariablesAt(int index) const;
+  void resizeFrames(int frameCount);
+  void invalidateExpandedFrames();
+  void connectVirtualMachineService();
+  void disconnectVirtualMachineService();
+};
+
+#endif
@@ -5,7 +5,11 @@
 #include <qtmetamacros.h>
 
 #include <QAbstractItemModel>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QCryptographicHash>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QList>
 #include <QMap>
 #include <QMutex>
@@ -21,10 +25,12 @@
 #include <stdexcept>
 
 #include "VM/include/program.hpp"
+#include "breakpointstore.hpp"
 #include "compilerservice.hpp"
 #include "dialogservice.hpp"
 #include "executionstate.hpp"
 #include "filesystemservice.hpp"
+#include "largefilemodel.hpp"
 #include "virtualmachineservice.hpp"
 
 using FileOptional = std::optional<QSharedPointer<QFile>>;
@@ -54,14 +60,34 @@ class TabModel {
       : _textDocument(nullptr),
         _file(file),
         _name(name),
-        _storedText(storedText) {}
+        _storedText(storedText),
+        _savedContentHash(contentHash(storedText)) {
+    _inactiveTimer.start();
+  }
   TabModel(const QString& name) : TabModel(name, std::nullopt, QString()) {}
   TabModel(const TabModel& tabModel)
       : _textDocument(tabModel._textDocument),
         _file(tabModel._file),
         _name(tabModel._name),
         _storedText(tabModel._storedText),
-        _activeBreakPoints(tabModel._activeBreakPoints) {}
+        _savedContentHash(tabModel._savedContentHash),
+        _largeFileModel(tabModel._largeFileModel),
+        _differsFromSaved(tabModel._differsFromSaved),
+        _contentChanged(tabModel._contentChanged),
+        _reportedModified(tabModel._reportedModified),
+        _hibernated(tabModel._hibernated),
+        _hibernatedContent(tabModel._hibernatedContent),
+        _hibernatedBreakPoints(tabModel._hibernatedBreakPoints),
+        _hibernatedModified(tabModel._hibernatedModified),
+        _revisionOffset(tabModel._revisionOffset),
+        _inactiveTimer(tabModel._inactiveTimer) {}
+
+  static QByteArray contentHash(const QString& content) {
+    return QCryptographicHash::hash(
+        QByteArrayView(reinterpret_cast<const char*>(content.constData()),
+                       content.size() * sizeof(QChar)),
+        QCryptographicHash::Sha1);
+  }
 
   QString name() const { return _name; }
   QString displayName() const {
@@ -72,10 +98,56 @@ class TabModel {
   }
   FileOptional file() const { return _file; }
   QString storedText() const { return _storedText; }
-  QList<int> activeBreakPoints() const { return _activeBreakPoints; }
+  BreakPointStore* breakPointStore() const {
+    return BreakPointStore::of(_textDocument.data());
+  }
+  QList<int> breakPointLineNumbers() const {
+    const BreakPointStore* const store = breakPointStore();
+    return store == nullptr ? _hibernatedBreakPoints : store->lineNumbers();
+  }
+  bool isHibernated() const { return _hibernated; }
+  QString hibernatedContent() const {
+    return QString::fromUtf8(qUncompress(_hibernatedContent));
+  }
+  // Every new document starts counting revisions again, so the revisions of
+  // the documents before it are carried over and never decrease.
+  int revision() const {
+    if (_hibernated || !_textDocument) {
+      return _revisionOffset;
+    }
+    return _revisionOffset + _textDocument->revision();
+  }
+  qint64 inactiveMs() const { return _inactiveTimer.elapsed(); }
   QPointer<QTextDocument> textDocument() const { return _textDocument; }
+  QSharedPointer<LargeFileModel> largeFileModel() const {
+    return _largeFileModel;
+  }
+  bool isLargeFile() const { return !_largeFileModel.isNull(); }
   bool isModified() const {
-    return _textDocument && _textDocument->isModified();
+    if (_hibernated || _hibernatedModified) {
+      return _hibernatedModified;
+    }
+    if (isLargeFile()) {
+      return _largeFileModel->isModified();
+    }
+    // An edit after the last comparison counts as modified until the
+    // content is compared again, so unsaved work is never reported as saved.
+    return _textDocument && _textDocument->isModified() &&
+           (_contentChanged || _differsFromSaved);
+  }
+  // Both return whether isModified() changed since it was last reported.
+  bool markContentChanged() {
+    _contentChanged = true;
+    return reportModified();
+  }
+  // Compares the document with the saved content. Callers debounce it, so
+  // typing does not hash on every keystroke.
+  bool updateModified() {
+    _differsFromSaved =
+        _textDocument && _textDocument->isModified() &&
+        contentHash(_textDocument->toPlainText()) != _savedContentHash;
+    _contentChanged = false;
+    return reportModified();
   }
   bool isTemporary() const { return !_file.has_value(); }
   int cursorLineNumber() const { return _cursorLineNumber; }
@@ -83,10 +155,43 @@ class TabModel {
 
   void setName(const QString& name) { _name = name; }
   void setStoredText(const QString& text) { _storedText = text; }
-  void setActiveBreakPoints(QList<int> activeBreakPoints) {
-    _activeBreakPoints = activeBreakPoints;
+  void releaseStoredText() { _storedText = QString(); }
+  void markInactive() { _inactiveTimer.start(); }
+  // Keeps the content, breakpoints and modification state compressed in
+  // memory so the text document can be destroyed.
+  void hibernate() {
+    _hibernatedContent = qCompress(_textDocument->toPlainText().toUtf8());
+    _hibernatedBreakPoints = breakPointLineNumbers();
+    _hibernatedModified = isModified();
+    _reportedModified = _hibernatedModified;
+    _revisionOffset += _textDocument->revision();
+    _hibernated = true;
+    _differsFromSaved = false;
+    _contentChanged = false;
+    _textDocument = nullptr;
+  }
+  void wake() {
+    _storedText = hibernatedContent();
+    _hibernatedContent.clear();
+    _hibernated = false;
+  }
+  void restoreHibernatedState() {
+    BreakPointStore* const store = breakPointStore();
+    if (store != nullptr) {
+      for (const int lineNumber : std::as_const(_hibernatedBreakPoints)) {
+        store->setBreakPoint(lineNumber, true);
+      }
+    }
+    if (_hibernatedModified && _textDocument) {
+      _textDocument->setModified(true);
+    }
+    _hibernatedBreakPoints.clear();
+    _hibernatedModified = false;
   }
   void setFile(FileOptional file) { _file = file; }
+  void setLargeFileModel(QSharedPointer<LargeFileModel> largeFileModel) {
+    _largeFileModel = largeFileModel;
+  }
   void setTextDocument(QTextDocument* textDocument) {
     _textDocument = textDocument;
   }
@@ -102,13 +207,34 @@ class TabModel {
   std::optional<QSharedPointer<QFile>> _file;
   QString _name;
   QString _storedText;
-  QList<int> _activeBreakPoints;
+  QByteArray _savedContentHash;
+  QSharedPointer<LargeFileModel> _largeFileModel;
+  bool _differsFromSaved = false;
+  bool _contentChanged = false;
+  bool _reportedModified = false;
+  bool _hibernated = false;
+  QByteArray _hibernatedContent;
+  QList<int> _hibernatedBreakPoints;
+  bool _hibernatedModified = false;
+  int _revisionOffset = 0;
+  QElapsedTimer _inactiveTimer;
   int _cursorLineNumber = 1;
   int _cursorPosition = 0;
+
+  bool reportModified() {
+    const bool modified = isModified();
+    if (_reportedModified == modified) {
+      return false;
+    }
+    _reportedModified = modified;
+    return true;
+  }
 };
 
 using TabModelOptional = std::optional<QSharedPointer<TabModel>>;
 
+class ExecutionSession;
+
 class EditorModel : public QAbstractListModel {
   Q_OBJECT
   Q_PROPERTY(int mainTabIndex READ mainTabIndex WRITE setMainTabIndex NOTIFY
@@ -132,6 +258,11 @@ class EditorModel : public QAbstractListModel {
                  setExecutionTimeoutMs NOTIFY executionTimeoutMsChanged)
   Q_PROPERTY(ExecutionState executionState READ executionState NOTIFY
                  executionStateChanged)
+  Q_PROPERTY(ExecutionSession* currentSession READ currentSession NOTIFY
+                 currentSessionChanged)
+  Q_PROPERTY(int hibernationTimeoutMs READ hibernationTimeoutMs WRITE
+                 setHibernationTimeoutMs NOTIFY hibernationTimeoutMsChanged)
+  Q_MOC_INCLUDE("executionsession.hpp")
   QML_ELEMENT
  public:
   EditorModel(QObject* parent = nullptr);
@@ -149,6 +280,9 @@ class EditorModel : public QAbstractListModel {
     CursorPositionRole,
     CursorPositionEditRole,
     CursorLineNumberRole,
+    ExecutionStateRole,
+    LargeFileModelRole,
+    IsHibernatedRole,
   };
   enum RunningMode {
     Default,
@@ -167,11 +301,14 @@ class EditorModel : public QAbstractListModel {
   int currentTabIndex() const;
   int executionTimeoutMs() const;
   int compilationTimeoutMs() const;
+  int hibernationTimeoutMs() const;
   ExecutionState executionState() const;
+  ExecutionSession* currentSession() const;
   int rowCount(const QModelIndex& index) const override;
   RunningMode runningMode() const;
   void saveTabAt(qsizetype index);
   void closeTabAt(qsizetype index);
+  std::optional<CompilationTask> currentCompilationTask() const;
 
   Q_INVOKABLE
   void openFile(const QUrl& url);
@@ -183,9 +320,23 @@ class EditorModel : public QAbstractListModel {
   void runScript();
   Q_INVOKABLE
   void runScriptInDebugMode();
+  Q_INVOKABLE
+  void applyChanges();
+  Q_INVOKABLE
+  void replayRecording(const QUrl& url);
+  Q_INVOKABLE
+  void stepOver();
+  Q_INVOKABLE
+  void stepOut();
+  Q_INVOKABLE
+  void runToCursor();
+  Q_INVOKABLE
+  void hibernateInactiveTabs();
 
  public slots:
   void createTabFromFile(QSharedPointer<QFile> file, const QString& storedText);
+  void createLargeFileTab(QSharedPointer<QFile> file,
+                          QSharedPointer<PieceTable> pieceTable);
   void displayFileReadFailure(QSharedPointer<QFile> file,
                               const FileError& error);
   void setCompilerService(CompilerService* compilerservice);
@@ -203,6 +354,7 @@ class EditorModel : public QAbstractListModel {
   void stopExecution();
   void setExecutionTimeoutMs(int value);
   void setCompilationTimeoutMs(int value);
+  void setHibernationTimeoutMs(int value);
 
  signals:
   void currentTabIndexChanged(int index);
@@ -214,15 +366,23 @@ class EditorModel : public QAbstractListModel {
   void runningModeChanged(RunningMode runningMode);
   void executionTimeoutMsChanged();
   void compilationTimeoutMsChanged();
+  void hibernationTimeoutMsChanged();
   void executionStateChanged();
+  void currentSessionChanged();
 
  protected slots:
   void updateMainTabIndex();
   void updateAllTabNames();
-  void handleCompilationRevisionAvailable(int revision);
-  void handleExecutionCompleted();
+  void handleCompilationResultAvailable(
+      QSharedPointer<CompilationResult> compilationResult);
   void displayExecutionFailedForInternalReason();
-  void handleVirtualMachineVariableStateChanged();
+  void displayMemoryLimitExceeded(qint64 memoryLimitBytes);
+  void displayHotSwapCompleted(bool resumed,
+                               const QStringList& changedVariables);
+  void displayReplayFailed(const QString& reason);
+  void updateSessionSettings();
+  void updateCurrentSession();
+  void hibernateExpiredTabs();
 
  private:
   int _mainTabIndex = -1;
@@ -235,18 +395,22 @@ class EditorModel : public QAbstractListModel {
   mutable QMutex _tabsMutex;
   mutable QMutex _temporaryTabIndexesMutex;
   QMap<QSharedPointer<TabModel>, int> _temporaryTabIndexes;
-  long long _currentRunRevision = 0;
-  RunningMode _runningMode = Default;
-  ExecutionState _executionState = ExecutionState::Idle;
-  QTimer _executionStateTimer;
+  QMap<QSharedPointer<TabModel>, QSharedPointer<ExecutionSession>> _sessions;
+  QPointer<ExecutionSession> _currentSession;
   int _compilationTimeoutMs = 5000;
   int _executionTimeoutMs = 5000;
+  int _hibernationTimeoutMs = 0;
+  QTimer _hibernationTimer;
+  QTimer _modifiedCheckTimer;
+  QWeakPointer<TabModel> _modifiedCheckTab;
 
   QString tabNameAt(qsizetype index) const;
   QString storedTabTextAt(qsizetype index) const;
+  LargeFileModel* largeFileModelAt(qsizetype index) const;
   bool isTabModifiedAt(qsizetype index) const;
   bool isTabTemporaryAt(qsizetype index) const;
   bool isTabReadOnlyAt(qsizetype index) const;
+  bool isTabHibernatedAt(qsizetype index) const;
   bool tabIndexOutOfRange(qsizetype index) const;
   TabModelOptional mainTab() const;
   TabModelOptional tabAt(qsizetype index) const;
@@ -263,14 +427,30 @@ class EditorModel : public QAbstractListModel {
   bool setOpenAt(qsizetype index, const QVariant& data);
   CompilationTask createCompilationTaskFromTabContent() const;
   void updateTabNameAt(qsizetype index);
-  bool tryPushCompilationTask();
+  bool tryPushCompilationTask(RunningMode runningMode,
+                              const QString& replayLogPath = QString());
   bool compilationPreconditionsFulfilled() const;
   bool isMainTabIndex(int index) const;
   void connectVirtualMachineService();
   void disconnectVirtualMachineService();
-  void startVirtualMachine(const Theo::Program& program);
-  void setRunningMode(RunningMode runningMode);
-  QSharedPointer<CompilationResult> latestCompilationResult() const;
+  void startVirtualMachine(ExecutionSession* session,
+                           QSharedPointer<CompilationResult> compilationResult);
+  QSharedPointer<ExecutionSession> sessionOf(
+      QSharedPointer<TabModel> tab) const;
+  QSharedPointer<ExecutionSession> sessionAt(qsizetype index) const;
+  QSharedPointer<ExecutionSession> sessionOfMainTabName(
+      const QString& mainTabName) const;
+  QSharedPointer<ExecutionSession> createSessionFor(
+      QSharedPointer<TabModel> tab);
+  void connectSession(QSharedPointer<TabModel> tab,
+                      QSharedPointer<ExecutionSession> session);
+  void removeSessionOf(QSharedPointer<TabModel> tab);
+  void applyVirtualMachineSettings(VirtualMachineService* service) const;
+  void handleSessionExecutionStateChanged(QSharedPointer<TabModel> tab);
+  void handleExecutionHalted(ExecutionSession* session);
+  void hotSwapSession(ExecutionSession* session,
+                      QSharedPointer<CompilationResult> compilationResult);
+  ExecutionState executionStateAt(qsizetype index) const;
   int cursorPositionAt(int index) const;
   int cursorLineNumberAt(int index) const;
   bool setCursorPositionAt(int index, int position);
@@ -282,10 +462,21 @@ class EditorModel : public QAbstractListModel {
   bool setLineNumberAt(int index, int lineNumber);
   void updateCursorPositionFromLineNumberAt(int index);
   void updateLineNumberFromCursorPositionAt(int index);
-  void startExecutionStateTimer();
-  void setExecutionState(ExecutionState executionState);
-  void stopVirtualMachine();
-  void stopCompiler();
+  void startExecutionStateTimer(ExecutionSession* session);
+  void stopSession(ExecutionSession* session);
+  VirtualMachineService* resumeCurrentSession();
+  void connectTextDocument(QSharedPointer<TabModel> tab);
+  void updateTabModified(QSharedPointer<TabModel> tab);
+  void scheduleTabModifiedUpdate(QSharedPointer<TabModel> tab);
+  void emitTabModifiedChanged(QSharedPointer<TabModel> tab);
+  void connectBreakPointStore(QSharedPointer<TabModel> tab);
+  void disconnectBreakPointStore(QSharedPointer<TabModel> tab);
+  void applyBreakPointAt(const QString& tabName, int lineNumber,
+                         bool active) const;
+  void applyBreakPoints(VirtualMachineService* service) const;
+  bool canHibernateTabAt(qsizetype index) const;
+  void hibernateTabAt(qsizetype index);
+  void wakeTabAt(qsizetype index);
 };
 
 #endif
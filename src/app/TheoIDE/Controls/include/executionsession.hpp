@@ -0,0 +1,57 @@
+#ifndef _THEOIDE_CONTROLS_EXECUTIONSESSION_
+#define _THEOIDE_CONTROLS_EXECUTIONSESSION_
+
+#include <QFuture>
+#include <QObject>
+#include <QTimer>
+#include <QtQmlIntegration>
+
+#include "editormodel.hpp"
+#include "executionstate.hpp"
+#include "virtualmachineservice.hpp"
+
+class ExecutionSession : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(VirtualMachineService* virtualMachineService READ
+                 virtualMachineService CONSTANT)
+  Q_PROPERTY(ExecutionState executionState READ executionState NOTIFY
+                 executionStateChanged)
+  Q_PROPERTY(EditorModel::RunningMode runningMode READ runningMode NOTIFY
+                 runningModeChanged)
+  QML_ELEMENT
+  QML_UNCREATABLE("Execution sessions are created by the editor model")
+ public:
+  ExecutionSession(QObject* parent = nullptr);
+  ~ExecutionSession();
+  VirtualMachineService* virtualMachineService() const;
+  ExecutionState executionState() const;
+  EditorModel::RunningMode runningMode() const;
+  long long currentRunRevision() const;
+  bool isHotSwapPending() const;
+  QString replayLogPath() const;
+  void setExecutionState(ExecutionState executionState);
+  void setRunningMode(EditorModel::RunningMode runningMode);
+  void setCurrentRunRevision(long long revision);
+  void setHotSwapPending(bool hotSwapPending);
+  void setReplayLogPath(const QString& replayLogPath);
+  void startExecutionStateTimer(int timeoutMs);
+  void setCompilation(const QFuture<void>& compilation);
+  void cancelCompilation();
+
+ signals:
+  void executionStateChanged();
+  void runningModeChanged();
+  void executionStateTimedOut();
+
+ private:
+  VirtualMachineService* _virtualMachineService;
+  ExecutionState _executionState = ExecutionState::Idle;
+  EditorModel::RunningMode _runningMode = EditorModel::Default;
+  long long _currentRunRevision = 0;
+  bool _hotSwapPending = false;
+  QString _replayLogPath;
+  QTimer _executionStateTimer;
+  QFuture<void> _compilation;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef _THEOIDE_CONTROLS_LARGEFILEMODEL_
+#define _THEOIDE_CONTROLS_LARGEFILEMODEL_
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QVariant>
+#include <QtQmlIntegration>
+
+#include "piecetable.hpp"
+
+class LargeFileModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(bool isModified READ isModified NOTIFY isModifiedChanged)
+  QML_ELEMENT
+  QML_UNCREATABLE("Large file models are created by the editor model")
+ public:
+  LargeFileModel(QSharedPointer<PieceTable> pieceTable,
+                 QObject* parent = nullptr);
+  ~LargeFileModel();
+  enum LargeFileModelRole {
+    LineNumberRole = Qt::UserRole + 1,
+    LineTextRole,
+  };
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  bool setData(const QModelIndex& index, const QVariant& value,
+               int role = Qt::EditRole) override;
+  Qt::ItemFlags flags(const QModelIndex& index) const override;
+  QHash<int, QByteArray> roleNames() const override;
+  bool isModified() const;
+  int revision() const;
+  QString text();
+
+  Q_INVOKABLE
+  void splitLine(int lineIndex, int column);
+  Q_INVOKABLE
+  void joinWithPreviousLine(int lineIndex);
+
+ signals:
+  void isModifiedChanged();
+  // Lets views write edits they have not committed yet before the text is
+  // read.
+  void aboutToReadText();
+
+ private:
+  QSharedPointer<PieceTable> _pieceTable;
+  int _revision = 0;
+
+  bool indexOutOfRange(int index) const;
+  void markModified();
+};
+
+#endif
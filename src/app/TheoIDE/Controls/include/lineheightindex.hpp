@@ -0,0 +1,31 @@
+#ifndef _THEOIDE_CONTROLS_LINEHEIGHTINDEX_
+#define _THEOIDE_CONTROLS_LINEHEIGHTINDEX_
+
+#include <QList>
+
+// Heights of the lines of a document in a Fenwick tree, so the offset of a
+// line and the line at an offset are both found in O(log n). Inserting or
+// removing lines only marks the tree stale, it is rebuilt in O(n) on the
+// next query so a batch of structural edits costs a single rebuild.
+class LineHeightIndex {
+ public:
+  int lineCount() const;
+  qreal heightAt(int line) const;
+  qreal offsetOf(int line) const;
+  qreal totalHeight() const;
+  int lineAt(qreal offset) const;
+
+  void reset(int lineCount, qreal height);
+  void insertLines(int line, int count, qreal height);
+  void removeLines(int line, int count);
+  bool setHeightAt(int line, qreal height);
+
+ private:
+  QList<qreal> _heights;
+  mutable QList<qreal> _tree;
+  mutable bool _stale = false;
+
+  void rebuildIfStale() const;
+};
+
+#endif
@@ -2,36 +2,28 @@
 #define _THEOIDE_CONTROLS_LINEINFOCOLUMNMODEL_
 
 #include <QAbstractListModel>
+#include <QAbstractTextDocumentLayout>
 #include <QByteArray>
 #include <QHash>
 #include <QList>
 #include <QModelIndex>
+#include <QPointer>
 #include <QQuickTextDocument>
+#include <QRectF>
 #include <QString>
-#include <QTextBlockUserData>
+#include <QTextBlock>
 #include <QTextDocument>
 #include <QtQmlIntegration>
 
-class LineInfoUserData : public QTextBlockUserData {
- public:
-  LineInfoUserData() : QTextBlockUserData(), _breakPointActive(false) {}
-  LineInfoUserData(const LineInfoUserData& userData)
-      : QTextBlockUserData(userData),
-        _breakPointActive(userData._breakPointActive) {}
-  ~LineInfoUserData() {}
-
-  bool breakPointActive() const { return _breakPointActive; }
-  void setBreakPointActive(const bool value) { _breakPointActive = value; }
-
- private:
-  bool _breakPointActive;
-};
+#include "breakpointstore.hpp"
+#include "lineheightindex.hpp"
 
 class LineInfoColumnModel : public QAbstractListModel {
   Q_OBJECT
   Q_PROPERTY(int lineCount READ lineCount NOTIFY lineCountChanged)
   Q_PROPERTY(QQuickTextDocument* textDocument READ quickTextDocument WRITE
                  setQuickTextDocument NOTIFY quickTextDocumentChanged)
+  Q_PROPERTY(qreal contentHeight READ contentHeight NOTIFY lineHeightsChanged)
   QML_ELEMENT
  public:
   LineInfoColumnModel(QObject* parent = nullptr);
@@ -44,6 +36,13 @@ class LineInfoColumnModel : public QAbstractListModel {
   int lineCount() const { return _lineCount; };
   Q_INVOKABLE
   QList<int> getLineNumbersWithActiveBreakpoints() const;
+  Q_INVOKABLE
+  qreal lineOffsetAt(int lineIndex) const;
+  Q_INVOKABLE
+  qreal lineHeightAt(int lineIndex) const;
+  Q_INVOKABLE
+  int lineIndexAt(qreal offset) const;
+  qreal contentHeight() const;
   virtual QVariant data(const QModelIndex& index,
                         int role = Qt::DisplayRole) const override;
   virtual int rowCount(
@@ -59,16 +58,23 @@ class LineInfoColumnModel : public QAbstractListModel {
 
  protected slots:
   void setTextDocument(QTextDocument* textDocument);
-  void updateLines(const int newLineCount);
-  void setLineCount(const int newLineCount);
+  void updateLines(int position, int charsRemoved, int charsAdded);
+  void updateBreakPointAt(int lineNumber);
+  void updateLineHeightsIn(const QRectF& rect);
+  void updateLineHeightOf(const QTextBlock& block);
+  void setDocumentLayout(QAbstractTextDocumentLayout* documentLayout);
 
  signals:
   void lineCountChanged(int newLineCount);
   void quickTextDocumentChanged();
+  void lineHeightsChanged();
 
  private:
   QQuickTextDocument* _quickTextDocument = nullptr;
   QTextDocument* _textDocument = nullptr;
+  QPointer<BreakPointStore> _breakPointStore;
+  QPointer<QAbstractTextDocumentLayout> _documentLayout;
+  LineHeightIndex _lineHeights;
   int _lineCount = 0;
 
   bool getBreakPointActiveAt(const int blockNumber) const;
@@ -79,6 +85,9 @@ class LineInfoColumnModel : public QAbstractListModel {
   void disconnectTextDocumentSignals();
   void insertLines(const int position, const int numberOfLines);
   void removeLines(const int position, const int numberOfLines);
+  void resetLines();
+  qreal layoutHeightOf(const QTextBlock& block) const;
+  void updateLineHeights(const QTextBlock& first, const QTextBlock& last);
 };
 
 #endif
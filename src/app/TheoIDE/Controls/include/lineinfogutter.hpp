@@ -0,0 +1,105 @@
+#ifndef _THEOIDE_CONTROLS_LINEINFOGUTTER_
+#define _THEOIDE_CONTROLS_LINEINFOGUTTER_
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QHoverEvent>
+#include <QMouseEvent>
+#include <QPointer>
+#include <QQuickItem>
+#include <QSGNode>
+#include <QSGTextNode>
+#include <QSharedPointer>
+#include <QTextLayout>
+#include <QtQmlIntegration>
+
+#include "lineinfocolumnmodel.hpp"
+
+class LineInfoGutter : public QQuickItem {
+  Q_OBJECT
+  Q_PROPERTY(LineInfoColumnModel* model READ model WRITE setModel NOTIFY
+                 modelChanged)
+  Q_PROPERTY(qreal contentY READ contentY WRITE setContentY NOTIFY
+                 contentYChanged)
+  Q_PROPERTY(qreal topMargin READ topMargin WRITE setTopMargin NOTIFY
+                 topMarginChanged)
+  Q_PROPERTY(qreal horizontalPadding READ horizontalPadding WRITE
+                 setHorizontalPadding NOTIFY horizontalPaddingChanged)
+  Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+  Q_PROPERTY(QColor textColor READ textColor WRITE setTextColor NOTIFY
+                 colorsChanged)
+  Q_PROPERTY(QColor hoverColor READ hoverColor WRITE setHoverColor NOTIFY
+                 colorsChanged)
+  Q_PROPERTY(QColor breakPointColor READ breakPointColor WRITE
+                 setBreakPointColor NOTIFY colorsChanged)
+  Q_PROPERTY(QColor breakPointTextColor READ breakPointTextColor WRITE
+                 setBreakPointTextColor NOTIFY colorsChanged)
+  QML_ELEMENT
+ public:
+  LineInfoGutter(QQuickItem* parent = nullptr);
+  ~LineInfoGutter();
+  LineInfoColumnModel* model() const;
+  qreal contentY() const;
+  qreal topMargin() const;
+  qreal horizontalPadding() const;
+  QFont font() const;
+  QColor textColor() const;
+  QColor hoverColor() const;
+  QColor breakPointColor() const;
+  QColor breakPointTextColor() const;
+
+ public slots:
+  void setModel(LineInfoColumnModel* model);
+  void setContentY(qreal contentY);
+  void setTopMargin(qreal topMargin);
+  void setHorizontalPadding(qreal horizontalPadding);
+  void setFont(const QFont& font);
+  void setTextColor(const QColor& color);
+  void setHoverColor(const QColor& color);
+  void setBreakPointColor(const QColor& color);
+  void setBreakPointTextColor(const QColor& color);
+
+ signals:
+  void modelChanged();
+  void contentYChanged();
+  void topMarginChanged();
+  void horizontalPaddingChanged();
+  void fontChanged();
+  void colorsChanged();
+
+ protected:
+  QSGNode* updatePaintNode(QSGNode* oldNode,
+                           UpdatePaintNodeData* updatePaintNodeData) override;
+  void mousePressEvent(QMouseEvent* event) override;
+  void hoverMoveEvent(QHoverEvent* event) override;
+  void hoverLeaveEvent(QHoverEvent* event) override;
+
+ protected slots:
+  void updateImplicitWidth();
+
+ private:
+  QPointer<LineInfoColumnModel> _model;
+  qreal _contentY = 0;
+  qreal _topMargin = 0;
+  qreal _horizontalPadding = 0;
+  QFont _font;
+  QColor _textColor;
+  QColor _hoverColor;
+  QColor _breakPointColor;
+  QColor _breakPointTextColor;
+  int _hoveredLineIndex = -1;
+  bool _layoutsInvalidated = false;
+  QHash<int, QSharedPointer<QTextLayout>> _layouts;
+  QSGTextNode* _textNode = nullptr;
+  QSGTextNode* _breakPointTextNode = nullptr;
+
+  int lineIndexAt(qreal y) const;
+  QTextLayout* layoutOf(int lineIndex);
+  void pruneLayouts(int firstLineIndex, int lastLineIndex);
+  void setHoveredLineIndex(int lineIndex);
+  void connectModel();
+  void disconnectModel();
+};
+
+#endif
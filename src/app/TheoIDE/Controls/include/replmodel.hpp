@@ -0,0 +1,63 @@
+#ifndef _THEOIDE_CONTROLS_REPLMODEL_
+#define _THEOIDE_CONTROLS_REPLMODEL_
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVariant>
+#include <QtQmlIntegration>
+
+#include "replservice.hpp"
+
+struct ReplEntry {
+  QString input;
+  QString output;
+  bool succeeded;
+};
+
+class ReplModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(ReplService* replService READ replService WRITE setReplService
+                 NOTIFY replServiceChanged)
+  QML_ELEMENT
+ public:
+  ReplModel(QObject* parent = nullptr);
+  ~ReplModel();
+  enum ReplModelRole {
+    InputRole = Qt::UserRole + 1,
+    OutputRole,
+    SucceededRole,
+  };
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+  ReplService* replService() const;
+
+  Q_INVOKABLE
+  void clear();
+
+ public slots:
+  void setReplService(ReplService* replService);
+
+ signals:
+  void replServiceChanged();
+
+ protected slots:
+  void appendEntry(const QString& snippet, const QMap<QString, int>& variables,
+                   const QString& error);
+
+ private:
+  QPointer<ReplService> _replService;
+  QList<ReplEntry> _entries;
+
+  bool indexOutOfRange(int index) const;
+  void connectReplService();
+  void disconnectReplService();
+};
+
+#endif
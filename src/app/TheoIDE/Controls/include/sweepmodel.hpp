@@ -0,0 +1,76 @@
+#ifndef _THEOIDE_CONTROLS_SWEEPMODEL_
+#define _THEOIDE_CONTROLS_SWEEPMODEL_
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVariant>
+#include <QtQmlIntegration>
+#include <optional>
+
+#include "editormodel.hpp"
+#include "virtualmachineservice.hpp"
+
+class SweepModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(EditorModel* editorModel READ editorModel WRITE setEditorModel
+                 NOTIFY editorModelChanged)
+  Q_PROPERTY(
+      VirtualMachineService* virtualMachineService READ virtualMachineService
+          WRITE setVirtualMachineService NOTIFY virtualMachineServiceChanged)
+  Q_PROPERTY(int variantCount READ variantCount NOTIFY variantCountChanged)
+  QML_ELEMENT
+ public:
+  SweepModel(QObject* parent = nullptr);
+  ~SweepModel();
+  enum SweepModelRole {
+    VariantIndexRole = Qt::UserRole + 1,
+    OverridesRole,
+    VariablesRole,
+    SucceededRole,
+    ErrorRole,
+  };
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+  EditorModel* editorModel() const;
+  VirtualMachineService* virtualMachineService() const;
+  int variantCount() const;
+
+  Q_INVOKABLE
+  bool start(const QString& variantsText);
+  Q_INVOKABLE
+  void stop();
+
+ public slots:
+  void setEditorModel(EditorModel* editorModel);
+  void setVirtualMachineService(VirtualMachineService* virtualMachineService);
+
+ signals:
+  void editorModelChanged();
+  void virtualMachineServiceChanged();
+  void variantCountChanged();
+
+ protected slots:
+  void clearResults(int variantCount);
+  void insertResult(const SweepResult& result);
+
+ private:
+  QPointer<EditorModel> _editorModel;
+  QPointer<VirtualMachineService> _virtualMachineService;
+  QList<SweepResult> _results;
+  int _variantCount = 0;
+
+  bool indexOutOfRange(int index) const;
+  static std::optional<VariableOverrides> parseVariant(const QString& line);
+  static QString formatVariables(const QMap<QString, int>& variables);
+  void connectVirtualMachineService();
+  void disconnectVirtualMachineService();
+};
+
+#endif
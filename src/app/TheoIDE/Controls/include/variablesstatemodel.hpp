@@ -14,15 +14,20 @@
 #include <QVariant>
 #include <QtQmlIntegration>
 
+#include "symboltable.hpp"
+#include "variablesstatedelta.hpp"
 #include "virtualmachineservice.hpp"
 
 struct VariableState {
-  VariableState(const QString& name, int value) : name(name), value(value) {}
+  VariableState(SymbolId id, const QString& name, int value)
+      : id(id), name(name), value(value) {}
   VariableState(const VariableState& instance)
-      : name(instance.name),
+      : id(instance.id),
+        name(instance.name),
         value(instance.value),
         nameColumnImplicitWidth(instance.nameColumnImplicitWidth),
         valueColumnImplicitWidth(instance.valueColumnImplicitWidth) {}
+  SymbolId id;
   QString name;
   int value;
   int nameColumnImplicitWidth = 0;
@@ -75,7 +80,8 @@ class VariablesStateModel : public QAbstractListModel {
   void setVariableValueColumnWidth(int value);
   void updateVariableNameColumnWidth();
   void updateVariableValueColumnWidth();
-  void updateVariablesState();
+  void resetVariablesState();
+  void applyVariablesStateDelta(const VariablesStateDelta& delta);
 
  private:
   QPointer<VirtualMachineService> _virtualMachineService;
@@ -93,6 +99,9 @@ class VariablesStateModel : public QAbstractListModel {
   bool setVariableValueColumnImplicitWidthVariant(int index,
                                                   const QVariant& value);
   bool indexOutOfRange(int index) const;
+  QList<VariableState>::iterator findInsertPosition(const QString& name);
+  int indexOf(SymbolId id);
+  VariableState createVariableState(SymbolId id, int value) const;
   void setValueAt(int index, int value);
   void setValueAt(QList<VariableState>::iterator iterator, int value);
   QList<VariableState>::iterator insertVariableStateAt(
@@ -0,0 +1,69 @@
+#ifndef _THEOIDE_CONTROLS_WATCHMODEL_
+#define _THEOIDE_CONTROLS_WATCHMODEL_
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+#include <QtQmlIntegration>
+
+#include "variablesstatedelta.hpp"
+#include "virtualmachineservice.hpp"
+#include "watchexpression.hpp"
+
+struct WatchEntry {
+  WatchExpression expression;
+  WatchValue result;
+};
+
+class WatchModel : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(
+      VirtualMachineService* virtualMachineService READ virtualMachineService
+          WRITE setVirtualMachineService NOTIFY virtualMachineServiceChanged)
+  QML_ELEMENT
+ public:
+  WatchModel(QObject* parent = nullptr);
+  ~WatchModel();
+  enum WatchModelRole {
+    ExpressionRole = Qt::UserRole + 1,
+    ValueRole,
+    ErrorRole,
+  };
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+  VirtualMachineService* virtualMachineService() const;
+
+  Q_INVOKABLE
+  bool add(const QString& expression);
+  Q_INVOKABLE
+  void remove(int index);
+
+ public slots:
+  void setVirtualMachineService(VirtualMachineService* virtualMachineService);
+
+ signals:
+  void virtualMachineServiceChanged();
+
+ protected slots:
+  void updateWatches(const VariablesStateDelta& delta);
+
+ private:
+  QPointer<VirtualMachineService> _virtualMachineService;
+  QList<WatchEntry> _entries;
+
+  bool indexOutOfRange(int index) const;
+  QMap<QString, int> variablesState() const;
+  void evaluateAll();
+  void connectVirtualMachineService();
+  void disconnectVirtualMachineService();
+};
+
+#endif
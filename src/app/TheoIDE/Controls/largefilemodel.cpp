@@ -0,0 +1,115 @@
+#include <qtpreprocessorsupport.h>
+
+#include <limits>
+
+#include "largefilemodel.hpp"
+
+LargeFileModel::LargeFileModel(QSharedPointer<PieceTable> pieceTable,
+                               QObject* parent)
+    : QAbstractListModel(parent), _pieceTable(pieceTable) {}
+
+LargeFileModel::~LargeFileModel() {}
+
+int LargeFileModel::rowCount(const QModelIndex& parent) const {
+  Q_UNUSED(parent)
+  return static_cast<int>(qMin(_pieceTable->lineCount(),
+                               qint64(std::numeric_limits<int>::max())));
+}
+
+QVariant LargeFileModel::data(const QModelIndex& index, int role) const {
+  if (indexOutOfRange(index.row())) {
+    return QVariant();
+  }
+  switch (role) {
+    case LineNumberRole:
+      return index.row() + 1;
+    case Qt::DisplayRole:
+    case LineTextRole:
+      return _pieceTable->lineAt(index.row());
+  }
+  return QVariant();
+}
+
+bool LargeFileModel::setData(const QModelIndex& index, const QVariant& value,
+                             int role) {
+  if (indexOutOfRange(index.row()) || role != LineTextRole ||
+      !value.canConvert<QString>()) {
+    return false;
+  }
+  const QString text = value.toString();
+  if (text == _pieceTable->lineAt(index.row())) {
+    return true;
+  }
+  _pieceTable->replaceLine(index.row(), text);
+  markModified();
+  emit dataChanged(index, index, {Qt::DisplayRole, LineTextRole});
+  return true;
+}
+
+Qt::ItemFlags LargeFileModel::flags(const QModelIndex& index) const {
+  Q_UNUSED(index)
+  return Qt::ItemFlag::ItemIsEnabled | Qt::ItemFlag::ItemIsEditable |
+         Qt::ItemFlag::ItemNeverHasChildren;
+}
+
+QHash<int, QByteArray> LargeFileModel::roleNames() const {
+  return QHash<int, QByteArray>{
+      {Qt::DisplayRole, "display"},
+      {LineNumberRole, "lineNumber"},
+      {LineTextRole, "lineText"},
+  };
+}
+
+bool LargeFileModel::isModified() const { return _revision > 0; }
+
+int LargeFileModel::revision() const { return _revision; }
+
+QString LargeFileModel::text() {
+  emit aboutToReadText();
+  return QString::fromUtf8(_pieceTable->toByteArray());
+}
+
+void LargeFileModel::splitLine(int lineIndex, int column) {
+  if (indexOutOfRange(lineIndex)) {
+    return;
+  }
+  const QString line = _pieceTable->lineAt(lineIndex);
+  const qint64 offset = _pieceTable->lineOffsetAt(lineIndex) +
+                        line.first(qBound(0, column, int(line.size())))
+                            .toUtf8()
+                            .size();
+  beginInsertRows(QModelIndex(), lineIndex + 1, lineIndex + 1);
+  _pieceTable->insert(offset, "\n");
+  endInsertRows();
+  markModified();
+  const QModelIndex modelIndex = index(lineIndex);
+  emit dataChanged(modelIndex, modelIndex, {Qt::DisplayRole, LineTextRole});
+}
+
+void LargeFileModel::joinWithPreviousLine(int lineIndex) {
+  if (lineIndex <= 0 || indexOutOfRange(lineIndex)) {
+    return;
+  }
+  const qint64 previousLineEnd =
+      _pieceTable->lineOffsetAt(lineIndex - 1) +
+      _pieceTable->lineLengthAt(lineIndex - 1);
+  beginRemoveRows(QModelIndex(), lineIndex, lineIndex);
+  _pieceTable->remove(previousLineEnd,
+                      _pieceTable->lineOffsetAt(lineIndex) - previousLineEnd);
+  endRemoveRows();
+  markModified();
+  const QModelIndex modelIndex = index(lineIndex - 1);
+  emit dataChanged(modelIndex, modelIndex, {Qt::DisplayRole, LineTextRole});
+}
+
+bool LargeFileModel::indexOutOfRange(int index) const {
+  return index < 0 || index >= rowCount();
+}
+
+void LargeFileModel::markModified() {
+  const bool wasModified = isModified();
+  ++_revision;
+  if (!wasModified) {
+    emit isModifiedChanged();
+  }
+}
@@ -0,0 +1,86 @@
+#include <bit>
+
+#include "lineheightindex.hpp"
+
+int LineHeightIndex::lineCount() const { return _heights.size(); }
+
+qreal LineHeightIndex::heightAt(int line) const {
+  if (line < 0 || line >= _heights.size()) {
+    return 0;
+  }
+  return _heights.at(line);
+}
+
+qreal LineHeightIndex::offsetOf(int line) const {
+  rebuildIfStale();
+  qreal offset = 0;
+  for (qsizetype i = qBound(0, line, int(_heights.size())); i > 0;
+       i &= i - 1) {
+    offset += _tree.at(i - 1);
+  }
+  return offset;
+}
+
+qreal LineHeightIndex::totalHeight() const { return offsetOf(lineCount()); }
+
+int LineHeightIndex::lineAt(qreal offset) const {
+  rebuildIfStale();
+  const qsizetype size = _tree.size();
+  if (size == 0) {
+    return 0;
+  }
+  qsizetype position = 0;
+  for (qsizetype step = std::bit_floor(size_t(size)); step > 0; step >>= 1) {
+    const qsizetype next = position + step;
+    if (next <= size && _tree.at(next - 1) <= offset) {
+      position = next;
+      offset -= _tree.at(next - 1);
+    }
+  }
+  return qMin(int(position), int(size) - 1);
+}
+
+void LineHeightIndex::reset(int lineCount, qreal height) {
+  _heights.fill(height, lineCount);
+  _stale = true;
+}
+
+void LineHeightIndex::insertLines(int line, int count, qreal height) {
+  _heights.insert(line, count, height);
+  _stale = true;
+}
+
+void LineHeightIndex::removeLines(int line, int count) {
+  _heights.remove(line, count);
+  _stale = true;
+}
+
+bool LineHeightIndex::setHeightAt(int line, qreal height) {
+  if (line < 0 || line >= _heights.size() || _heights.at(line) == height) {
+    return false;
+  }
+  const qreal difference = height - _heights.at(line);
+  _heights[line] = height;
+  if (_stale) {
+    return true;
+  }
+  for (qsizetype i = line + 1; i <= _tree.size(); i += i & -i) {
+    _tree[i - 1] += difference;
+  }
+  return true;
+}
+
+void LineHeightIndex::rebuildIfStale() const {
+  if (!_stale) {
+    return;
+  }
+  _tree = _heights;
+  const qsizetype size = _tree.size();
+  for (qsizetype i = 1; i <= size; ++i) {
+    const qsizetype parent = i + (i & -i);
+    if (parent <= size) {
+      _tree[parent - 1] += _tree.at(i - 1);
+    }
+  }
+  _stale = false;
+}
@@ -1,5 +1,7 @@
 #include <qtpreprocessorsupport.h>
 
+#include <QTextBlock>
+#include <QTextLayout>
 #include <QtLogging>
 
 #include "lineinfocolumnmodel.hpp"
@@ -7,33 +9,76 @@
 LineInfoColumnModel::LineInfoColumnModel(QObject* parent)
     : QAbstractListModel(parent) {}
 
-void LineInfoColumnModel::updateLines(const int newLineCount) {
-  const int currentLineCount = _lineCount;
-  if (newLineCount == currentLineCount) {
+void LineInfoColumnModel::updateLines(int position, int charsRemoved,
+                                      int charsAdded) {
+  Q_UNUSED(charsRemoved)
+  const int lineCount = _textDocument->blockCount();
+  const int lastPosition = _textDocument->characterCount() - 1;
+  const int firstLine =
+      _textDocument->findBlock(qMin(position, lastPosition)).blockNumber();
+  const int lastAddedLine =
+      _textDocument->findBlock(qMin(position + charsAdded, lastPosition))
+          .blockNumber();
+  if (firstLine < 0 || lastAddedLine < firstLine) {
+    resetLines();
     return;
   }
-  const QModelIndex firstLine = createIndex(0, 0);
-  const QModelIndex lastLine = createIndex(currentLineCount - 1, 0);
-  emit dataChanged(firstLine, lastLine);
-  const int lineCountDifference = newLineCount - currentLineCount;
-  if (lineCountDifference > 0) {
-    insertLines(currentLineCount, lineCountDifference);
-  } else {
-    removeLines(currentLineCount, -lineCountDifference);
+  const int addedLineCount = lastAddedLine - firstLine;
+  const int removedLineCount = addedLineCount - (lineCount - _lineCount);
+  if (removedLineCount < 0 || firstLine + removedLineCount >= _lineCount) {
+    resetLines();
+    return;
+  }
+  // Lines that were replaced in place keep their rows, only the surplus of
+  // added or removed lines is inserted or removed right after them.
+  const int replacedLineCount = qMin(addedLineCount, removedLineCount);
+  const int firstMovedLine = firstLine + replacedLineCount + 1;
+  if (addedLineCount > removedLineCount) {
+    insertLines(firstMovedLine, addedLineCount - removedLineCount);
+  } else if (removedLineCount > addedLineCount) {
+    removeLines(firstMovedLine, removedLineCount - addedLineCount);
+  }
+  emit dataChanged(createIndex(firstLine, 0),
+                   createIndex(firstLine + replacedLineCount, 0));
+  updateLineHeights(_textDocument->findBlockByNumber(firstLine),
+                    _textDocument->findBlockByNumber(lastAddedLine));
+}
+
+void LineInfoColumnModel::resetLines() {
+  beginResetModel();
+  const int lineCount =
+      _textDocument == nullptr ? 0 : _textDocument->blockCount();
+  _lineCount = lineCount;
+  _lineHeights.reset(lineCount, 0);
+  if (_textDocument != nullptr) {
+    for (QTextBlock block = _textDocument->begin();
+         block != _textDocument->end(); block = block.next()) {
+      _lineHeights.setHeightAt(block.blockNumber(), layoutHeightOf(block));
+    }
   }
-  setLineCount(newLineCount);
+  endResetModel();
+  emit lineCountChanged(lineCount);
+  emit lineHeightsChanged();
 }
 
 void LineInfoColumnModel::insertLines(const int position,
                                       const int numberOfLines) {
   beginInsertRows(QModelIndex(), position, position + numberOfLines - 1);
+  _lineCount += numberOfLines;
+  _lineHeights.insertLines(position, numberOfLines, 0);
   endInsertRows();
+  emit lineCountChanged(_lineCount);
+  emit lineHeightsChanged();
 }
 
 void LineInfoColumnModel::removeLines(const int position,
                                       const int numberOfLines) {
-  beginRemoveRows(QModelIndex(), position - numberOfLines, position - 1);
+  beginRemoveRows(QModelIndex(), position, position + numberOfLines - 1);
+  _lineCount -= numberOfLines;
+  _lineHeights.removeLines(position, numberOfLines);
   endRemoveRows();
+  emit lineCountChanged(_lineCount);
+  emit lineHeightsChanged();
 }
 
 bool LineInfoColumnModel::isTextDocumentUnexpectedlyNull() const {
@@ -59,27 +104,99 @@ QVariant LineInfoColumnModel::data(const QModelIndex& index, int role) const {
 }
 
 qreal LineInfoColumnModel::getLineHeightAt(const int blockNumber) const {
-  if (isTextDocumentUnexpectedlyNull()) {
+  return _lineHeights.heightAt(blockNumber);
+}
+
+qreal LineInfoColumnModel::lineOffsetAt(int lineIndex) const {
+  return _lineHeights.offsetOf(lineIndex);
+}
+
+qreal LineInfoColumnModel::lineHeightAt(int lineIndex) const {
+  return _lineHeights.heightAt(lineIndex);
+}
+
+int LineInfoColumnModel::lineIndexAt(qreal offset) const {
+  return _lineHeights.lineAt(offset);
+}
+
+qreal LineInfoColumnModel::contentHeight() const {
+  return _lineHeights.totalHeight();
+}
+
+qreal LineInfoColumnModel::layoutHeightOf(const QTextBlock& block) const {
+  if (!block.isValid() || block.layout() == nullptr) {
     return 0;
   }
-  QTextBlock block = _textDocument->findBlockByNumber(blockNumber);
-  if (block.blockNumber() >= 0 && block.layout() != nullptr) {
-    return block.layout()->boundingRect().height();
+  return block.layout()->boundingRect().height();
+}
+
+void LineInfoColumnModel::updateLineHeights(const QTextBlock& first,
+                                            const QTextBlock& last) {
+  if (!first.isValid() || !last.isValid()) {
+    return;
+  }
+  int firstChangedLine = -1;
+  int lastChangedLine = -1;
+  for (QTextBlock block = first;
+       block.isValid() && block.blockNumber() <= last.blockNumber();
+       block = block.next()) {
+    const int lineIndex = block.blockNumber();
+    if (_lineHeights.setHeightAt(lineIndex, layoutHeightOf(block))) {
+      if (firstChangedLine < 0) {
+        firstChangedLine = lineIndex;
+      }
+      lastChangedLine = lineIndex;
+    }
+  }
+  if (firstChangedLine < 0) {
+    return;
+  }
+  emit dataChanged(createIndex(firstChangedLine, 0),
+                   createIndex(lastChangedLine, 0), {LineHeightRole});
+  emit lineHeightsChanged();
+}
+
+void LineInfoColumnModel::updateLineHeightsIn(const QRectF& rect) {
+  if (_textDocument == nullptr || _documentLayout.isNull()) {
+    return;
   }
-  return 0;
+  const int firstPosition = _documentLayout->hitTest(
+      QPointF(rect.left(), qMax(rect.top(), qreal(0))), Qt::FuzzyHit);
+  const int lastPosition = _documentLayout->hitTest(
+      QPointF(rect.left(), rect.bottom()), Qt::FuzzyHit);
+  const QTextBlock first = firstPosition < 0
+                               ? _textDocument->firstBlock()
+                               : _textDocument->findBlock(firstPosition);
+  const QTextBlock last = lastPosition < 0
+                              ? _textDocument->lastBlock()
+                              : _textDocument->findBlock(lastPosition);
+  updateLineHeights(first, last);
+}
+
+void LineInfoColumnModel::updateLineHeightOf(const QTextBlock& block) {
+  updateLineHeights(block, block);
+}
+
+void LineInfoColumnModel::setDocumentLayout(
+    QAbstractTextDocumentLayout* documentLayout) {
+  if (!_documentLayout.isNull()) {
+    disconnect(_documentLayout, nullptr, this, nullptr);
+  }
+  _documentLayout = QPointer(documentLayout);
+  if (_documentLayout.isNull()) {
+    return;
+  }
+  connect(_documentLayout, &QAbstractTextDocumentLayout::update, this,
+          &LineInfoColumnModel::updateLineHeightsIn);
+  connect(_documentLayout, &QAbstractTextDocumentLayout::updateBlock, this,
+          &LineInfoColumnModel::updateLineHeightOf);
 }
 
 bool LineInfoColumnModel::getBreakPointActiveAt(const int blockNumber) const {
-  if (isTextDocumentUnexpectedlyNull()) {
+  if (isTextDocumentUnexpectedlyNull() || _breakPointStore.isNull()) {
     return false;
   }
-  QTextBlock block = _textDocument->findBlockByNumber(blockNumber);
-  if (block.blockNumber() >= 0 && block.userData() != nullptr) {
-    const LineInfoUserData* userData =
-        static_cast<LineInfoUserData*>(block.userData());
-    return userData->breakPointActive();
-  }
-  return false;
+  return _breakPointStore->contains(blockNumber + 1);
 }
 
 bool LineInfoColumnModel::setData(const QModelIndex& index,
@@ -105,7 +222,7 @@ Qt::ItemFlags LineInfoColumnModel::flags(const QModelIndex& index) const {
 
 bool LineInfoColumnModel::setBreakPointActiveAt(const QModelIndex& index,
                                                 const QVariant& value) {
-  if (isTextDocumentUnexpectedlyNull()) {
+  if (isTextDocumentUnexpectedlyNull() || _breakPointStore.isNull()) {
     return false;
   }
   const int blockNumber = index.row();
@@ -114,28 +231,16 @@ bool LineInfoColumnModel::setBreakPointActiveAt(const QModelIndex& index,
       !value.canConvert<bool>()) {
     return false;
   }
+  return _breakPointStore->setBreakPoint(blockNumber + 1, value.toBool());
+}
 
-  QTextBlock block = _textDocument->findBlockByNumber(blockNumber);
-  if (block.blockNumber() < 0) {
-    return false;
-  }
-
-  const bool nextValue = value.toBool();
-
-  LineInfoUserData* userData;
-  if (block.userData() == nullptr) {
-    userData = new LineInfoUserData();
-    block.setUserData(userData);
-  } else {
-    userData = static_cast<LineInfoUserData*>(block.userData());
-  }
-
-  const bool currentValue = userData->breakPointActive();
-  if (nextValue != currentValue) {
-    userData->setBreakPointActive(nextValue);
-    emit dataChanged(index, index);
+void LineInfoColumnModel::updateBreakPointAt(int lineNumber) {
+  const int blockNumber = lineNumber - 1;
+  if (blockNumber < 0 || blockNumber >= _lineCount) {
+    return;
   }
-  return true;
+  const QModelIndex modelIndex = createIndex(blockNumber, 0);
+  emit dataChanged(modelIndex, modelIndex, {BreakPointActiveRole});
 }
 
 QHash<int, QByteArray> LineInfoColumnModel::roleNames() const {
@@ -166,12 +271,26 @@ void LineInfoColumnModel::disconnectTextDocumentSignals() {
   if (_textDocument != nullptr) {
     disconnect(_textDocument, nullptr, this, nullptr);
   }
+  if (!_breakPointStore.isNull()) {
+    disconnect(_breakPointStore, nullptr, this, nullptr);
+  }
 }
 
 void LineInfoColumnModel::connectTextDocumentSignals() {
   if (_textDocument != nullptr) {
-    connect(_textDocument, &QTextDocument::blockCountChanged, this,
+    connect(_textDocument, &QTextDocument::contentsChange, this,
             &LineInfoColumnModel::updateLines);
+    connect(_textDocument, &QTextDocument::documentLayoutChanged, this,
+            [this]() -> void {
+              setDocumentLayout(_textDocument->documentLayout());
+              resetLines();
+            });
+  }
+  setDocumentLayout(_textDocument == nullptr ? nullptr
+                                             : _textDocument->documentLayout());
+  if (!_breakPointStore.isNull()) {
+    connect(_breakPointStore, &BreakPointStore::breakPointChanged, this,
+            &LineInfoColumnModel::updateBreakPointAt);
   }
 }
 
@@ -179,33 +298,15 @@ void LineInfoColumnModel::setTextDocument(QTextDocument* textDocument) {
   if (textDocument != _textDocument) {
     disconnectTextDocumentSignals();
     _textDocument = textDocument;
+    _breakPointStore = QPointer(BreakPointStore::of(textDocument));
     connectTextDocumentSignals();
   }
-  if (_textDocument == nullptr) {
-    setLineCount(0);
-  } else {
-    updateLines(_textDocument->blockCount());
-  }
-}
-
-void LineInfoColumnModel::setLineCount(const int newLineCount) {
-  if (_lineCount != newLineCount) {
-    _lineCount = newLineCount;
-    emit lineCountChanged(newLineCount);
-  }
+  resetLines();
 }
 
 QList<int> LineInfoColumnModel::getLineNumbersWithActiveBreakpoints() const {
-  QList<int> returnValue;
-  if (isTextDocumentUnexpectedlyNull()) {
-    return returnValue;
-  }
-  for (QTextBlock block = _textDocument->begin(); block != _textDocument->end();
-       block = block.next()) {
-    if (block.userData() != nullptr &&
-        static_cast<LineInfoUserData*>(block.userData())->breakPointActive()) {
-      returnValue.push_back(block.blockNumber() + 1);
-    }
+  if (isTextDocumentUnexpectedlyNull() || _breakPointStore.isNull()) {
+    return QList<int>();
   }
-  return returnValue;
+  return _breakPointStore->lineNumbers();
 }
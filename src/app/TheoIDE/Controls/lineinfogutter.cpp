@@ -0,0 +1,296 @@
+#include <qtpreprocessorsupport.h>
+
+#include <QFontMetricsF>
+#include <QQuickWindow>
+#include <QSGRectangleNode>
+#include <QTextLine>
+
+#include "lineinfogutter.hpp"
+
+LineInfoGutter::LineInfoGutter(QQuickItem* parent) : QQuickItem(parent) {
+  setFlag(ItemHasContents, true);
+  setClip(true);
+  setAcceptedMouseButtons(Qt::LeftButton);
+  setAcceptHoverEvents(true);
+  connect(this, &QQuickItem::heightChanged, this, &QQuickItem::update);
+  connect(this, &QQuickItem::widthChanged, this, &QQuickItem::update);
+  updateImplicitWidth();
+}
+
+LineInfoGutter::~LineInfoGutter() {}
+
+LineInfoColumnModel* LineInfoGutter::model() const { return _model.data(); }
+
+qreal LineInfoGutter::contentY() const { return _contentY; }
+
+qreal LineInfoGutter::topMargin() const { return _topMargin; }
+
+qreal LineInfoGutter::horizontalPadding() const { return _horizontalPadding; }
+
+QFont LineInfoGutter::font() const { return _font; }
+
+QColor LineInfoGutter::textColor() const { return _textColor; }
+
+QColor LineInfoGutter::hoverColor() const { return _hoverColor; }
+
+QColor LineInfoGutter::breakPointColor() const { return _breakPointColor; }
+
+QColor LineInfoGutter::breakPointTextColor() const {
+  return _breakPointTextColor;
+}
+
+void LineInfoGutter::setModel(LineInfoColumnModel* model) {
+  if (_model != model) {
+    disconnectModel();
+    _model = QPointer(model);
+    emit modelChanged();
+    connectModel();
+    updateImplicitWidth();
+    update();
+  }
+}
+
+void LineInfoGutter::setContentY(qreal contentY) {
+  if (_contentY != contentY) {
+    _contentY = contentY;
+    emit contentYChanged();
+    update();
+  }
+}
+
+void LineInfoGutter::setTopMargin(qreal topMargin) {
+  if (_topMargin != topMargin) {
+    _topMargin = topMargin;
+    emit topMarginChanged();
+    update();
+  }
+}
+
+void LineInfoGutter::setHorizontalPadding(qreal horizontalPadding) {
+  if (_horizontalPadding != horizontalPadding) {
+    _horizontalPadding = horizontalPadding;
+    emit horizontalPaddingChanged();
+    updateImplicitWidth();
+    update();
+  }
+}
+
+void LineInfoGutter::setFont(const QFont& font) {
+  if (_font != font) {
+    _font = font;
+    _layoutsInvalidated = true;
+    emit fontChanged();
+    updateImplicitWidth();
+    update();
+  }
+}
+
+void LineInfoGutter::setTextColor(const QColor& color) {
+  if (_textColor != color) {
+    _textColor = color;
+    emit colorsChanged();
+    update();
+  }
+}
+
+void LineInfoGutter::setHoverColor(const QColor& color) {
+  if (_hoverColor != color) {
+    _hoverColor = color;
+    emit colorsChanged();
+    update();
+  }
+}
+
+void LineInfoGutter::setBreakPointColor(const QColor& color) {
+  if (_breakPointColor != color) {
+    _breakPointColor = color;
+    emit colorsChanged();
+    update();
+  }
+}
+
+void LineInfoGutter::setBreakPointTextColor(const QColor& color) {
+  if (_breakPointTextColor != color) {
+    _breakPointTextColor = color;
+    emit colorsChanged();
+    update();
+  }
+}
+
+QSGNode* LineInfoGutter::updatePaintNode(
+    QSGNode* oldNode, UpdatePaintNodeData* updatePaintNodeData) {
+  Q_UNUSED(updatePaintNodeData)
+  if (_layoutsInvalidated) {
+    _layouts.clear();
+    _layoutsInvalidated = false;
+  }
+  if (_model.isNull() || _model->lineCount() == 0) {
+    delete oldNode;
+    _textNode = nullptr;
+    _breakPointTextNode = nullptr;
+    return nullptr;
+  }
+  QSGNode* rootNode = oldNode;
+  if (rootNode == nullptr) {
+    rootNode = new QSGNode();
+    _textNode = window()->createTextNode();
+    _breakPointTextNode = window()->createTextNode();
+    rootNode->appendChildNode(_textNode);
+    rootNode->appendChildNode(_breakPointTextNode);
+  }
+  while (rootNode->firstChild() != _textNode) {
+    QSGNode* const backgroundNode = rootNode->firstChild();
+    rootNode->removeChildNode(backgroundNode);
+    delete backgroundNode;
+  }
+  _textNode->clear();
+  _breakPointTextNode->clear();
+  _textNode->setColor(_textColor);
+  _breakPointTextNode->setColor(_breakPointTextColor);
+
+  const qreal contentHeight = _model->contentHeight();
+  const qreal firstVisibleOffset = qMax(_contentY - _topMargin, qreal(0));
+  const qreal lastVisibleOffset = _contentY - _topMargin + height();
+  const int firstLineIndex = _model->lineIndexAt(firstVisibleOffset);
+  int lineIndex = firstLineIndex;
+  qreal lineOffset = _model->lineOffsetAt(lineIndex);
+  for (; lineIndex < _model->lineCount() && lineOffset < lastVisibleOffset &&
+         lineOffset < contentHeight;
+       ++lineIndex) {
+    const qreal lineHeight = _model->lineHeightAt(lineIndex);
+    const qreal y = lineOffset + _topMargin - _contentY;
+    const QModelIndex modelIndex = _model->index(lineIndex);
+    const bool breakPointActive =
+        _model->data(modelIndex, LineInfoColumnModel::BreakPointActiveRole)
+            .toBool();
+    QTextLayout* const layout = layoutOf(lineIndex);
+    const QTextLine textLine = layout->lineAt(0);
+    const QRectF numberRect(
+        width() - textLine.naturalTextWidth() - 2 * _horizontalPadding, y,
+        textLine.naturalTextWidth() + _horizontalPadding, lineHeight);
+    const bool hovered = lineIndex == _hoveredLineIndex;
+    if (breakPointActive || hovered) {
+      QSGRectangleNode* const backgroundNode = window()->createRectangleNode();
+      backgroundNode->setRect(numberRect);
+      backgroundNode->setColor(
+          breakPointActive
+              ? (hovered ? _breakPointColor.lighter(110) : _breakPointColor)
+              : _hoverColor);
+      rootNode->insertChildNodeBefore(backgroundNode, _textNode);
+    }
+    const QPointF position(
+        numberRect.left() + _horizontalPadding / 2,
+        y + (lineHeight - textLine.height()) / 2);
+    if (breakPointActive) {
+      _breakPointTextNode->addTextLayout(position, layout);
+    } else {
+      _textNode->addTextLayout(position, layout);
+    }
+    lineOffset += lineHeight;
+  }
+  pruneLayouts(firstLineIndex, lineIndex);
+  return rootNode;
+}
+
+QTextLayout* LineInfoGutter::layoutOf(int lineIndex) {
+  const auto cachedLayout = _layouts.constFind(lineIndex);
+  if (cachedLayout != _layouts.constEnd()) {
+    return cachedLayout.value().data();
+  }
+  auto layout = QSharedPointer<QTextLayout>(
+      new QTextLayout(QString::number(lineIndex + 1), _font));
+  layout->setCacheEnabled(true);
+  layout->beginLayout();
+  layout->createLine();
+  layout->endLayout();
+  _layouts.insert(lineIndex, layout);
+  return layout.data();
+}
+
+void LineInfoGutter::pruneLayouts(int firstLineIndex, int lastLineIndex) {
+  const int visibleLineCount = lastLineIndex - firstLineIndex;
+  if (_layouts.size() <= 4 * qMax(visibleLineCount, 64)) {
+    return;
+  }
+  for (auto iterator = _layouts.begin(); iterator != _layouts.end();) {
+    if (iterator.key() < firstLineIndex - visibleLineCount ||
+        iterator.key() > lastLineIndex + visibleLineCount) {
+      iterator = _layouts.erase(iterator);
+    } else {
+      ++iterator;
+    }
+  }
+}
+
+int LineInfoGutter::lineIndexAt(qreal y) const {
+  if (_model.isNull()) {
+    return -1;
+  }
+  const qreal offset = y + _contentY - _topMargin;
+  if (offset < 0 || offset >= _model->contentHeight()) {
+    return -1;
+  }
+  return _model->lineIndexAt(offset);
+}
+
+void LineInfoGutter::mousePressEvent(QMouseEvent* event) {
+  const int lineIndex = lineIndexAt(event->position().y());
+  if (lineIndex < 0) {
+    event->ignore();
+    return;
+  }
+  const QModelIndex modelIndex = _model->index(lineIndex);
+  const bool breakPointActive =
+      _model->data(modelIndex, LineInfoColumnModel::BreakPointActiveRole)
+          .toBool();
+  _model->setData(modelIndex, !breakPointActive,
+                  LineInfoColumnModel::BreakPointActiveRole);
+  event->accept();
+}
+
+void LineInfoGutter::hoverMoveEvent(QHoverEvent* event) {
+  setHoveredLineIndex(lineIndexAt(event->position().y()));
+}
+
+void LineInfoGutter::hoverLeaveEvent(QHoverEvent* event) {
+  Q_UNUSED(event)
+  setHoveredLineIndex(-1);
+}
+
+void LineInfoGutter::setHoveredLineIndex(int lineIndex) {
+  if (_hoveredLineIndex != lineIndex) {
+    _hoveredLineIndex = lineIndex;
+    update();
+  }
+}
+
+void LineInfoGutter::updateImplicitWidth() {
+  const int lineCount = _model.isNull() ? 1 : qMax(_model->lineCount(), 1);
+  const QString widestNumber(QString::number(lineCount).size(), '9');
+  const QFontMetricsF fontMetrics(_font);
+  setImplicitWidth(fontMetrics.horizontalAdvance(widestNumber) +
+                   3 * _horizontalPadding);
+}
+
+void LineInfoGutter::connectModel() {
+  if (_model.isNull()) {
+    return;
+  }
+  connect(_model, &LineInfoColumnModel::lineCountChanged, this,
+          &LineInfoGutter::updateImplicitWidth);
+  connect(_model, &LineInfoColumnModel::lineCountChanged, this,
+          &QQuickItem::update);
+  connect(_model, &LineInfoColumnModel::lineHeightsChanged, this,
+          &QQuickItem::update);
+  connect(_model, &LineInfoColumnModel::dataChanged, this,
+          &QQuickItem::update);
+  connect(_model, &LineInfoColumnModel::modelReset, this,
+          &QQuickItem::update);
+}
+
+void LineInfoGutter::disconnectModel() {
+  if (_model.isNull()) {
+    return;
+  }
+  disconnect(_model, nullptr, this, nullptr);
+}
@@ -0,0 +1,97 @@
+#include <qtpreprocessorsupport.h>
+
+#include <QStringList>
+
+#include "replmodel.hpp"
+
+ReplModel::ReplModel(QObject* parent) : QAbstractListModel(parent) {}
+
+ReplModel::~ReplModel() {}
+
+int ReplModel::rowCount(const QModelIndex& parent) const {
+  Q_UNUSED(parent)
+  return _entries.size();
+}
+
+QVariant ReplModel::data(const QModelIndex& index, int role) const {
+  if (indexOutOfRange(index.row())) {
+    return QVariant();
+  }
+  const ReplEntry& entry = _entries.at(index.row());
+  switch (role) {
+    case InputRole:
+      return entry.input;
+    case Qt::DisplayRole:
+    case OutputRole:
+      return entry.output;
+    case SucceededRole:
+      return entry.succeeded;
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> ReplModel::roleNames() const {
+  return QHash<int, QByteArray>{
+      {Qt::DisplayRole, "display"},
+      {InputRole, "input"},
+      {OutputRole, "output"},
+      {SucceededRole, "succeeded"},
+  };
+}
+
+ReplService* ReplModel::replService() const { return _replService.data(); }
+
+void ReplModel::setReplService(ReplService* replService) {
+  if (_replService != replService) {
+    disconnectReplService();
+    _replService = QPointer(replService);
+    emit replServiceChanged();
+    connectReplService();
+  }
+}
+
+void ReplModel::clear() {
+  beginResetModel();
+  _entries.clear();
+  endResetModel();
+  if (_replService) {
+    _replService->reset();
+  }
+}
+
+void ReplModel::appendEntry(const QString& snippet,
+                            const QMap<QString, int>& variables,
+                            const QString& error) {
+  QString output = error;
+  if (error.isEmpty()) {
+    QStringList assignments;
+    for (const auto& variable : variables.asKeyValueRange()) {
+      assignments.append(
+          QString("%1=%2").arg(variable.first).arg(variable.second));
+    }
+    output = assignments.join(", ");
+  }
+  const int row = _entries.size();
+  beginInsertRows(QModelIndex(), row, row);
+  _entries.append(ReplEntry{snippet, output, error.isEmpty()});
+  endInsertRows();
+}
+
+bool ReplModel::indexOutOfRange(int index) const {
+  return index < 0 || index >= _entries.size();
+}
+
+void ReplModel::connectReplService() {
+  if (_replService.isNull()) {
+    return;
+  }
+  connect(_replService, &ReplService::snippetEvaluated, this,
+          &ReplModel::appendEntry);
+}
+
+void ReplModel::disconnectReplService() {
+  if (_replService.isNull()) {
+    return;
+  }
+  disconnect(_replService, nullptr, this, nullptr);
+}
@@ -0,0 +1,180 @@
+#include <qtpreprocessorsupport.h>
+
+#include <QStringList>
+#include <algorithm>
+#include <iterator>
+
+#include "sweepmodel.hpp"
+
+SweepModel::SweepModel(QObject* parent) : QAbstractListModel(parent) {}
+
+SweepModel::~SweepModel() {}
+
+int SweepModel::rowCount(const QModelIndex& parent) const {
+  Q_UNUSED(parent)
+  return _results.size();
+}
+
+QVariant SweepModel::data(const QModelIndex& index, int role) const {
+  if (indexOutOfRange(index.row())) {
+    return QVariant();
+  }
+  const SweepResult& result = _results.at(index.row());
+  switch (role) {
+    case VariantIndexRole:
+      return result.variantIndex;
+    case OverridesRole:
+      return formatVariables(result.overrides);
+    case Qt::DisplayRole:
+    case VariablesRole:
+      return formatVariables(result.variables);
+    case SucceededRole:
+      return result.succeeded;
+    case ErrorRole:
+      return result.error;
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> SweepModel::roleNames() const {
+  return QHash<int, QByteArray>{
+      {Qt::DisplayRole, "display"},
+      {VariantIndexRole, "variantIndex"},
+      {OverridesRole, "overrides"},
+      {VariablesRole, "variables"},
+      {SucceededRole, "succeeded"},
+      {ErrorRole, "error"},
+  };
+}
+
+EditorModel* SweepModel::editorModel() const { return _editorModel.data(); }
+
+void SweepModel::setEditorModel(EditorModel* editorModel) {
+  if (_editorModel != editorModel) {
+    _editorModel = QPointer(editorModel);
+    emit editorModelChanged();
+  }
+}
+
+VirtualMachineService* SweepModel::virtualMachineService() const {
+  return _virtualMachineService.data();
+}
+
+void SweepModel::setVirtualMachineService(
+    VirtualMachineService* virtualMachineService) {
+  if (_virtualMachineService != virtualMachineService) {
+    disconnectVirtualMachineService();
+    _virtualMachineService = QPointer(virtualMachineService);
+    emit virtualMachineServiceChanged();
+    connectVirtualMachineService();
+  }
+}
+
+int SweepModel::variantCount() const { return _variantCount; }
+
+bool SweepModel::start(const QString& variantsText) {
+  if (_editorModel.isNull() || _virtualMachineService.isNull()) {
+    qCritical() << "Unable to start sweep because the editor model or the "
+                   "virtual machine service is null";
+    return false;
+  }
+  QList<VariableOverrides> variants;
+  for (const QString& line : variantsText.split('\n', Qt::SkipEmptyParts)) {
+    const auto variant = parseVariant(line);
+    if (!variant) {
+      qWarning() << "Ignoring invalid sweep variant" << line;
+      continue;
+    }
+    variants.append(*variant);
+  }
+  if (variants.isEmpty()) {
+    return false;
+  }
+  const auto task = _editorModel->currentCompilationTask();
+  if (!task) {
+    return false;
+  }
+  _virtualMachineService->sweep(*task, variants);
+  return true;
+}
+
+void SweepModel::stop() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  _virtualMachineService->stopSweep();
+}
+
+void SweepModel::clearResults(int variantCount) {
+  beginResetModel();
+  _results.clear();
+  _results.reserve(variantCount);
+  endResetModel();
+  if (_variantCount != variantCount) {
+    _variantCount = variantCount;
+    emit variantCountChanged();
+  }
+}
+
+void SweepModel::insertResult(const SweepResult& result) {
+  const auto position = std::lower_bound(
+      _results.begin(), _results.end(), result.variantIndex,
+      [](const SweepResult& element, int variantIndex) -> bool {
+        return element.variantIndex < variantIndex;
+      });
+  const int row = static_cast<int>(std::distance(_results.begin(), position));
+  beginInsertRows(QModelIndex(), row, row);
+  _results.insert(row, result);
+  endInsertRows();
+}
+
+bool SweepModel::indexOutOfRange(int index) const {
+  return index < 0 || index >= _results.size();
+}
+
+std::optional<VariableOverrides> SweepModel::parseVariant(const QString& line) {
+  VariableOverrides overrides;
+  for (const QString& assignment : line.split(',', Qt::SkipEmptyParts)) {
+    const QStringList parts = assignment.split('=');
+    if (parts.size() != 2) {
+      return std::nullopt;
+    }
+    const QString name = parts.at(0).trimmed();
+    bool isNumber = false;
+    const int value = parts.at(1).trimmed().toInt(&isNumber);
+    if (name.isEmpty() || !isNumber) {
+      return std::nullopt;
+    }
+    overrides.insert(name, value);
+  }
+  if (overrides.isEmpty()) {
+    return std::nullopt;
+  }
+  return overrides;
+}
+
+QString SweepModel::formatVariables(const QMap<QString, int>& variables) {
+  QStringList assignments;
+  for (const auto& variable : variables.asKeyValueRange()) {
+    assignments.append(
+        QString("%1=%2").arg(variable.first).arg(variable.second));
+  }
+  return assignments.join(", ");
+}
+
+void SweepModel::connectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  connect(_virtualMachineService, &VirtualMachineService::sweepStarted, this,
+          &SweepModel::clearResults);
+  connect(_virtualMachineService, &VirtualMachineService::sweepResultReady,
+          this, &SweepModel::insertResult);
+}
+
+void SweepModel::disconnectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  disconnect(_virtualMachineService, nullptr, this, nullptr);
+}
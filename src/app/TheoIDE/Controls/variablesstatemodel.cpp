@@ -14,10 +14,7 @@ VariablesStateModel::~VariablesStateModel() {}
 
 int VariablesStateModel::rowCount(const QModelIndex& parent) const {
   Q_UNUSED(parent)
-  if (_virtualMachineService.isNull()) {
-    return 0;
-  }
-  return _virtualMachineService->variablesState().count();
+  return _variables.size();
 }
 
 QVariant VariablesStateModel::data(const QModelIndex& index, int role) const {
@@ -71,6 +68,7 @@ void VariablesStateModel::setVirtualMachineService(
     _virtualMachineService = QPointer(virtualMachineService);
     emit virtualMachineServiceChanged();
     connectVirtualMachineService();
+    resetVariablesState();
   }
 }
 
@@ -132,46 +130,72 @@ void VariablesStateModel::updateVariableValueColumnWidth() {
   setVariableValueColumnWidth(maxWidth);
 }
 
-void VariablesStateModel::updateVariablesState() {
-  if (_virtualMachineService.isNull()) {
-    return;
+void VariablesStateModel::resetVariablesState() {
+  beginResetModel();
+  _variables.clear();
+  if (_virtualMachineService) {
+    const auto variablesState = _virtualMachineService->variablesStateById();
+    for (const auto& variable : variablesState.asKeyValueRange()) {
+      _variables.append(createVariableState(variable.first, variable.second));
+    }
+    std::sort(_variables.begin(), _variables.end(),
+              [](const VariableState& v1, const VariableState& v2) -> bool {
+                return v1.name < v2.name;
+              });
   }
-  const auto variablesState(_virtualMachineService->variablesState());
-  QList<VariableState> variablesToAppend;
-  QList<VariableState>::iterator variablesIterator = _variables.begin();
-  const int numberOfItemsToUpdate =
-      qMin(variablesState.size(), _variables.size());
-  for (const QString& variableName : variablesState.keys()) {
-    if (variablesIterator == _variables.end()) {
-      variablesToAppend.append(
-          VariableState(variableName, variablesState[variableName]));
-      continue;
+  endResetModel();
+  updateVariableNameColumnWidth();
+  updateVariableValueColumnWidth();
+}
+
+void VariablesStateModel::applyVariablesStateDelta(
+    const VariablesStateDelta& delta) {
+  for (const SymbolId id : delta.removed()) {
+    const int index = indexOf(id);
+    if (index != -1) {
+      removeVariableStateAt(index);
     }
-    VariableState& currentVariableState = *variablesIterator;
-    currentVariableState.name = variableName;
-    currentVariableState.value = variablesState[variableName];
-    ++variablesIterator;
   }
-  if (numberOfItemsToUpdate > 0) {
-    const QModelIndex first(createIndex(0, 0));
-    const QModelIndex last(createIndex(numberOfItemsToUpdate - 1, 0));
-    emit dataChanged(first, last,
-                     {VariableNameRole, VariableValueRole, Qt::DisplayRole});
+  for (const VariableEntry& entry : delta.added()) {
+    const VariableState state = createVariableState(entry.first, entry.second);
+    insertVariableStateAt(findInsertPosition(state.name), state);
+  }
+  for (const VariableEntry& entry : delta.changed()) {
+    setValueAt(indexOf(entry.first), entry.second);
+  }
+  if (!delta.removed().isEmpty()) {
+    updateVariableNameColumnWidth();
+    updateVariableValueColumnWidth();
+  }
+}
+
+QList<VariableState>::iterator VariablesStateModel::findInsertPosition(
+    const QString& name) {
+  return std::lower_bound(
+      _variables.begin(), _variables.end(), name,
+      [](const VariableState& state, const QString& name) -> bool {
+        return state.name < name;
+      });
+}
+
+int VariablesStateModel::indexOf(SymbolId id) {
+  if (_virtualMachineService.isNull()) {
+    return -1;
   }
-  if (!variablesToAppend.isEmpty()) {
-    const int first = _variables.size();
-    const int last = first + variablesToAppend.size() - 1;
-    beginInsertRows(QModelIndex(), first, last);
-    _variables.append(variablesToAppend);
-    endInsertRows();
+  const auto iterator =
+      findInsertPosition(_virtualMachineService->symbolName(id));
+  if (iterator == _variables.end() || iterator->id != id) {
+    return -1;
   }
-  if (variablesState.size() < _variables.size()) {
-    const int first = variablesState.size();
-    const int last = _variables.size() - 1;
-    beginRemoveRows(QModelIndex(), first, last);
-    _variables.remove(first, last - first + 1);
-    endRemoveRows();
+  return std::distance(_variables.begin(), iterator);
+}
+
+VariableState VariablesStateModel::createVariableState(SymbolId id,
+                                                       int value) const {
+  if (_virtualMachineService.isNull()) {
+    return VariableState(id, QString(), value);
   }
+  return VariableState(id, _virtualMachineService->symbolName(id), value);
 }
 
 QString VariablesStateModel::variableNameAt(int index) const {
@@ -257,8 +281,8 @@ QList<VariableState>::iterator VariablesStateModel::insertVariableStateAt(
   const auto index(std::distance(_variables.begin(), iterator));
   beginInsertRows(QModelIndex(), index, index);
   const auto returnValue = _variables.insert(iterator, value);
-  return returnValue;
   endInsertRows();
+  return returnValue;
 }
 
 void VariablesStateModel::appendVariableState(const VariableState& state) {
@@ -281,8 +305,8 @@ void VariablesStateModel::connectVirtualMachineService() {
   if (_virtualMachineService.isNull()) {
     return;
   }
-  connect(_virtualMachineService, &VirtualMachineService::variablesStateChanged,
-          this, &VariablesStateModel::updateVariablesState);
+  connect(_virtualMachineService, &VirtualMachineService::variablesStateUpdated,
+          this, &VariablesStateModel::applyVariablesStateDelta);
 }
 
 void VariablesStateModel::disconnectVirtualMachineService() {
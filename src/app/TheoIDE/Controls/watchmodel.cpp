@@ -0,0 +1,147 @@
+#include <qtpreprocessorsupport.h>
+
+#include "watchmodel.hpp"
+
+WatchModel::WatchModel(QObject* parent) : QAbstractListModel(parent) {}
+
+WatchModel::~WatchModel() {}
+
+int WatchModel::rowCount(const QModelIndex& parent) const {
+  Q_UNUSED(parent)
+  return _entries.size();
+}
+
+QVariant WatchModel::data(const QModelIndex& index, int role) const {
+  if (indexOutOfRange(index.row())) {
+    return QVariant();
+  }
+  const WatchEntry& entry = _entries.at(index.row());
+  switch (role) {
+    case Qt::DisplayRole:
+    case ExpressionRole:
+      return entry.expression.source();
+    case ValueRole:
+      return entry.result.value.has_value() ? QVariant(*entry.result.value)
+                                            : QVariant();
+    case ErrorRole:
+      return entry.result.error;
+  }
+  return QVariant();
+}
+
+QHash<int, QByteArray> WatchModel::roleNames() const {
+  return QHash<int, QByteArray>{
+      {Qt::DisplayRole, "display"},
+      {ExpressionRole, "expression"},
+      {ValueRole, "value"},
+      {ErrorRole, "error"},
+  };
+}
+
+VirtualMachineService* WatchModel::virtualMachineService() const {
+  return _virtualMachineService.data();
+}
+
+void WatchModel::setVirtualMachineService(
+    VirtualMachineService* virtualMachineService) {
+  if (_virtualMachineService != virtualMachineService) {
+    disconnectVirtualMachineService();
+    _virtualMachineService = QPointer(virtualMachineService);
+    emit virtualMachineServiceChanged();
+    connectVirtualMachineService();
+    evaluateAll();
+  }
+}
+
+bool WatchModel::add(const QString& expression) {
+  WatchEntry entry;
+  try {
+    entry.expression = WatchExpression::compile(expression);
+  } catch (const WatchExpressionSyntaxError&) {
+    return false;
+  }
+  entry.result = entry.expression.evaluate(variablesState());
+  const int row = _entries.size();
+  beginInsertRows(QModelIndex(), row, row);
+  _entries.append(entry);
+  endInsertRows();
+  return true;
+}
+
+void WatchModel::remove(int index) {
+  if (indexOutOfRange(index)) {
+    return;
+  }
+  beginRemoveRows(QModelIndex(), index, index);
+  _entries.removeAt(index);
+  endRemoveRows();
+}
+
+void WatchModel::updateWatches(const VariablesStateDelta& delta) {
+  if (_entries.isEmpty() || delta.isEmpty()) {
+    return;
+  }
+  QSet<QString> changedNames;
+  for (const VariableEntry& variable : delta.added()) {
+    changedNames.insert(_virtualMachineService->symbolName(variable.first));
+  }
+  for (const VariableEntry& variable : delta.changed()) {
+    changedNames.insert(_virtualMachineService->symbolName(variable.first));
+  }
+  for (const SymbolId id : delta.removed()) {
+    changedNames.insert(_virtualMachineService->symbolName(id));
+  }
+  QMap<QString, int> variables;
+  bool variablesFetched = false;
+  for (qsizetype row = 0; row < _entries.size(); ++row) {
+    WatchEntry& entry = _entries[row];
+    if (!entry.expression.referencedVariables().intersects(changedNames)) {
+      continue;
+    }
+    if (!variablesFetched) {
+      variables = variablesState();
+      variablesFetched = true;
+    }
+    entry.result = entry.expression.evaluate(variables);
+    const QModelIndex modelIndex = createIndex(row, 0);
+    emit dataChanged(modelIndex, modelIndex, {ValueRole, ErrorRole});
+  }
+}
+
+bool WatchModel::indexOutOfRange(int index) const {
+  return index < 0 || index >= _entries.size();
+}
+
+QMap<QString, int> WatchModel::variablesState() const {
+  if (_virtualMachineService.isNull()) {
+    return QMap<QString, int>();
+  }
+  return _virtualMachineService->variablesState();
+}
+
+void WatchModel::evaluateAll() {
+  if (_entries.isEmpty()) {
+    return;
+  }
+  const QMap<QString, int> variables = variablesState();
+  for (WatchEntry& entry : _entries) {
+    entry.result = entry.expression.evaluate(variables);
+  }
+  emit dataChanged(createIndex(0, 0), createIndex(_entries.size() - 1, 0),
+                   {ValueRole, ErrorRole});
+}
+
+void WatchModel::connectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  connect(_virtualMachineService, &VirtualMachineService::variablesStateUpdated,
+          this, &WatchModel::updateWatches);
+}
+
+void WatchModel::disconnectVirtualMachineService() {
+  if (_virtualMachineService.isNull()) {
+    return;
+  }
+  disconnect(_virtualMachineService, nullptr, this, nullptr);
+}
@@ -1,3 +1,4 @@
+#include <QCryptographicHash>
 #include <QtConcurrentRun>
 #include <functional>
 #include <map>
@@ -8,21 +9,34 @@
 #include "gen.hpp"
 #include "scan.hpp"
 
+QByteArray CompilationTask::contentHash() const {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(_mainTabName.toUtf8());
+  for (const auto& file : _content.asKeyValueRange()) {
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(file.first.toUtf8());
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(file.second.toUtf8());
+  }
+  return hash.result();
+}
+
 CompilerService::CompilerService(QObject* parent) : QObject(parent) {}
 
 CompilerService::~CompilerService() {}
 
-bool CompilerService::checkRevisionAlreadyCompiled(int revision) {
-  if (_result.isNull()) {
+bool CompilerService::checkRevisionAlreadyCompiled(
+    const CompilationTask& task) {
+  if (_result.isNull() || _result->mainTabName() != task.mainTabName()) {
     return false;
   }
-  return _result->revision() >= revision;
+  return _result->revision() >= task.revision();
 }
 
-void CompilerService::compile(CompilationTask task) {
-  if (checkRevisionAlreadyCompiled(task.revision())) {
-    emit atLeastRevisionAvailable(task.revision());
-    return;
+QFuture<void> CompilerService::compile(CompilationTask task) {
+  if (checkRevisionAlreadyCompiled(task)) {
+    emit compilationResultAvailable(_result);
+    return QtFuture::makeReadyVoidFuture();
   }
   qInfo() << "Schedule compilation of revision" << task.revision();
   auto watcher = new QFutureWatcher<void>(this);
@@ -36,12 +50,13 @@ void CompilerService::compile(CompilationTask task) {
   const QFuture<void> future = compileAsync(task).then(
       [this, task](Theo::CodegenResult codegenResult) -> void {
         auto result = QSharedPointer<CompilationResult>(
-            new CompilationResult(task.revision(), codegenResult));
+            new CompilationResult(task, codegenResult, task.contentHash()));
         setResult(result);
-        emit atLeastRevisionAvailable(task.revision());
+        emit compilationResultAvailable(result);
         qInfo() << "Compilation of revision" << task.revision() << "done";
       });
   watcher->setFuture(future);
+  return future;
 }
 
 void CompilerService::setResult(QSharedPointer<CompilationResult> result) {
@@ -50,6 +65,7 @@ void CompilerService::setResult(QSharedPointer<CompilationResult> result) {
   }
   QMutexLocker locker(&_resultMutex);
   if (result.isNull() || _result.isNull() ||
+      result->mainTabName() != _result->mainTabName() ||
       result->revision() > _result->revision()) {
     _result = result;
     emit resultChanged();
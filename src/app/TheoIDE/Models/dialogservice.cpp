@@ -77,6 +77,52 @@ void DialogService::addMaxReadFileSizeExceeded(const QString& fileName,
   add(dto);
 }
 
+void DialogService::addMemoryLimitExceeded(const qint64 memoryLimitBytes) {
+  const QString title = tr("Memory limit exceeded");
+  const QString text = tr("The execution was aborted because the script used "
+                          "more than the memory limit of %1 bytes.")
+                           .arg(memoryLimitBytes);
+  const QString informativeText =
+      tr("Check the script for unbounded recursion or increase the memory "
+         "limit in the settings.");
+  auto dto = QSharedPointer<MessageDialogDTO>(
+      new MessageDialogDTO(title, text, std::nullopt, informativeText));
+  dto->setButton(DialogButton::Ok);
+  add(dto);
+}
+
+void DialogService::addHotSwapCompleted(const bool resumed,
+                                        const QStringList& changedVariables) {
+  const QString title = tr("Changes applied");
+  const QString text =
+      resumed ? tr("The changed script was executed again from the start up "
+                   "to the same halt, but some variables now hold different "
+                   "values.")
+              : tr("The changed script was executed again from the start, "
+                   "but could not be resumed at the same halt, because its "
+                   "layout differs from the halted script.");
+  const QString informativeText =
+      changedVariables.isEmpty()
+          ? tr("Restart the debugging session if the current state is not "
+               "what you expected.")
+          : tr("Variables with different values: %1")
+                .arg(changedVariables.join(", "));
+  auto dto = QSharedPointer<MessageDialogDTO>(
+      new MessageDialogDTO(title, text, std::nullopt, informativeText));
+  dto->setButton(DialogButton::Ok);
+  add(dto);
+}
+
+void DialogService::addReplayFailed(const QString& reason) {
+  const QString title = tr("Replay failed");
+  const QString text = tr("The recorded execution could not be replayed.");
+  const QString informativeText = reason;
+  auto dto = QSharedPointer<MessageDialogDTO>(
+      new MessageDialogDTO(title, text, std::nullopt, informativeText));
+  dto->setButton(DialogButton::Ok);
+  add(dto);
+}
+
 bool DialogService::isEmpty() const { return _dialogDTOs.empty(); }
 
 void DialogService::addNoScriptToCompile() {
@@ -0,0 +1,173 @@
+#include <QDataStream>
+#include <QtEndian>
+
+#include "executionlog.hpp"
+
+const QByteArray EXECUTION_LOG_MAGIC = QByteArrayLiteral("THEOLOG");
+// Bumped whenever the header or the records change layout. QDataStream is
+// pinned to the Qt 6.7 encoding so newer Qt versions read the same header.
+const quint8 EXECUTION_LOG_FORMAT_VERSION = 2;
+const QDataStream::Version EXECUTION_LOG_STREAM_VERSION = QDataStream::Qt_6_7;
+const quint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const quint64 FNV_PRIME = 1099511628211ULL;
+
+quint64 ExecutionLog::digest(const Theo::VM::Activation::Data& variables,
+                             qint32 callStackDepth) {
+  quint64 hash = FNV_OFFSET_BASIS;
+  const auto mix = [&hash](const void* data, size_t size) -> void {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t index = 0; index < size; ++index) {
+      hash = (hash ^ bytes[index]) * FNV_PRIME;
+    }
+  };
+  mix(&callStackDepth, sizeof(callStackDepth));
+  for (const auto& variable : variables) {
+    mix(variable.first.data(), variable.first.size());
+    const qint64 value = variable.second;
+    mix(&value, sizeof(value));
+  }
+  return hash;
+}
+
+ExecutionLogWriter::ExecutionLogWriter(
+    const QString& fileName, const QByteArray& programHash,
+    const QMap<QString, QSet<int>>& breakPoints)
+    : _file(fileName) {
+  if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    throw ExecutionLogOpenError();
+  }
+  QByteArray header;
+  QDataStream stream(&header, QIODevice::WriteOnly);
+  stream.setVersion(EXECUTION_LOG_STREAM_VERSION);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream.writeRawData(EXECUTION_LOG_MAGIC.constData(),
+                      EXECUTION_LOG_MAGIC.size());
+  stream << EXECUTION_LOG_FORMAT_VERSION;
+  stream << programHash;
+  stream << static_cast<quint32>(breakPoints.size());
+  for (const auto& file : breakPoints.asKeyValueRange()) {
+    stream << file.first << static_cast<quint32>(file.second.size());
+    for (const int lineNumber : file.second) {
+      stream << static_cast<qint32>(lineNumber);
+    }
+  }
+  const quint32 headerSize = static_cast<quint32>(header.size()) + 4;
+  QByteArray headerSizeBytes(4, Qt::Uninitialized);
+  qToLittleEndian(headerSize, headerSizeBytes.data());
+  _file.write(headerSizeBytes);
+  _file.write(header);
+}
+
+ExecutionLogWriter::~ExecutionLogWriter() { _file.close(); }
+
+void ExecutionLogWriter::append(const ExecutionLogRecord& record) {
+  char bytes[ExecutionLog::RECORD_SIZE_BYTES] = {};
+  bytes[0] = static_cast<char>(record.type);
+  qToLittleEndian(record.callStackDepth, bytes + 4);
+  qToLittleEndian(record.instruction, bytes + 8);
+  qToLittleEndian(record.digest, bytes + 16);
+  _file.write(bytes, sizeof(bytes));
+}
+
+ExecutionLogReader::ExecutionLogReader(const QString& fileName)
+    : _file(fileName) {
+  if (!_file.open(QIODevice::ReadOnly)) {
+    throw ExecutionLogOpenError();
+  }
+  _size = _file.size();
+  _data = _file.map(0, _size);
+  if (_data == nullptr) {
+    throw ExecutionLogOpenError();
+  }
+  readHeader();
+}
+
+ExecutionLogReader::~ExecutionLogReader() {
+  if (_data != nullptr) {
+    _file.unmap(const_cast<uchar*>(_data));
+  }
+}
+
+void ExecutionLogReader::readHeader() {
+  if (_size < 4) {
+    throw ExecutionLogFormatError();
+  }
+  _recordsOffset = qFromLittleEndian<quint32>(_data);
+  // The header size counts its own four bytes.
+  if (_recordsOffset < 4 || _recordsOffset > _size) {
+    throw ExecutionLogFormatError();
+  }
+  const QByteArray header = QByteArray::fromRawData(
+      reinterpret_cast<const char*>(_data) + 4, _recordsOffset - 4);
+  QDataStream stream(header);
+  stream.setVersion(EXECUTION_LOG_STREAM_VERSION);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  QByteArray magic(EXECUTION_LOG_MAGIC.size(), Qt::Uninitialized);
+  quint8 formatVersion = 0;
+  stream.readRawData(magic.data(), magic.size());
+  stream >> formatVersion;
+  if (magic != EXECUTION_LOG_MAGIC ||
+      formatVersion != EXECUTION_LOG_FORMAT_VERSION) {
+    throw ExecutionLogFormatError();
+  }
+  quint32 fileCount = 0;
+  stream >> _programHash >> fileCount;
+  for (quint32 fileIndex = 0; fileIndex < fileCount; ++fileIndex) {
+    QString fileName;
+    quint32 lineCount = 0;
+    stream >> fileName >> lineCount;
+    QSet<int>& lineNumbers = _breakPoints[fileName];
+    for (quint32 lineIndex = 0; lineIndex < lineCount; ++lineIndex) {
+      qint32 lineNumber = 0;
+      stream >> lineNumber;
+      lineNumbers.insert(lineNumber);
+    }
+  }
+  if (stream.status() != QDataStream::Ok) {
+    throw ExecutionLogFormatError();
+  }
+}
+
+QByteArray ExecutionLogReader::programHash() const { return _programHash; }
+
+QMap<QString, QSet<int>> ExecutionLogReader::breakPoints() const {
+  return _breakPoints;
+}
+
+qint64 ExecutionLogReader::recordCount() const {
+  return (_size - _recordsOffset) / ExecutionLog::RECORD_SIZE_BYTES;
+}
+
+ExecutionLogRecord ExecutionLogReader::recordAt(qint64 index) const {
+  const uchar* bytes =
+      _data + _recordsOffset + index * ExecutionLog::RECORD_SIZE_BYTES;
+  return ExecutionLogRecord{static_cast<ExecutionLogRecordType>(bytes[0]),
+                            qFromLittleEndian<qint32>(bytes + 4),
+                            qFromLittleEndian<qint64>(bytes + 8),
+                            qFromLittleEndian<quint64>(bytes + 16)};
+}
+
+qint64 ExecutionLogReader::indexAtOrAfter(qint64 instruction) const {
+  qint64 first = 0;
+  qint64 last = recordCount();
+  while (first < last) {
+    const qint64 middle = first + (last - first) / 2;
+    if (recordAt(middle).instruction < instruction) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return first;
+}
+
+bool ExecutionLogReader::matches(const ExecutionLogRecord& record) const {
+  const qint64 index = indexAtOrAfter(record.instruction);
+  if (index >= recordCount()) {
+    return false;
+  }
+  const ExecutionLogRecord expected = recordAt(index);
+  return expected.instruction == record.instruction &&
+         expected.callStackDepth == record.callStackDepth &&
+         expected.digest == record.digest;
+}
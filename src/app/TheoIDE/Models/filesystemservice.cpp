@@ -2,14 +2,17 @@
 #include <exception>
 
 #include "filesystemservice.hpp"
+#include "piecetable.hpp"
 
 const int DEFAULT_MAX_FILE_SIZE_BYTES = 2 * 1024 * 1024;
 const int DEFAULT_BLOCK_SIZE_BYTES = 1024;
+const int DEFAULT_LARGE_FILE_THRESHOLD_BYTES = 1024 * 1024;
 
 FileSystemService::FileSystemService(QObject* parent)
     : QObject(parent),
       _maxFileSizeBytes(DEFAULT_MAX_FILE_SIZE_BYTES),
-      _blockSizeBytes(DEFAULT_BLOCK_SIZE_BYTES) {}
+      _blockSizeBytes(DEFAULT_BLOCK_SIZE_BYTES),
+      _largeFileThresholdBytes(DEFAULT_LARGE_FILE_THRESHOLD_BYTES) {}
 
 FileSystemService::~FileSystemService() {}
 
@@ -17,11 +20,19 @@ int FileSystemService::maxFileSizeBytes() const { return _maxFileSizeBytes; }
 
 int FileSystemService::blockSizeBytes() const { return _blockSizeBytes; }
 
+int FileSystemService::largeFileThresholdBytes() const {
+  return _largeFileThresholdBytes;
+}
+
 QList<QSharedPointer<QFile>> FileSystemService::filesBeingRead() const {
   return _filesBeingRead;
 }
 
 void FileSystemService::readFile(QSharedPointer<QFile> file) {
+  if (file->exists() && file->size() > largeFileThresholdBytes()) {
+    readLargeFile(file);
+    return;
+  }
   QFutureWatcher<void>* watcher = new QFutureWatcher<void>(this);
   const std::function<void(void)> deleteWatcher = [watcher]() -> void {
     qInfo() << "File reading completed";
@@ -57,6 +68,33 @@ void FileSystemService::readFile(QSharedPointer<QFile> file) {
   addFileToBeingRead(file);
 }
 
+void FileSystemService::readLargeFile(QSharedPointer<QFile> file) {
+  QFutureWatcher<void>* watcher = new QFutureWatcher<void>(this);
+  connect(watcher, &QFutureWatcher<void>::finished, watcher,
+          &QObject::deleteLater);
+  const QString fileName = file->fileName();
+  QFuture future =
+      QtConcurrent::run([fileName]() -> QSharedPointer<PieceTable> {
+        return QSharedPointer<PieceTable>(new PieceTable(fileName));
+      })
+          .then([this, file](QSharedPointer<PieceTable> pieceTable) -> void {
+            removeFileFromBeingRead(file);
+            emit largeFileRead(file, pieceTable);
+          })
+          .onFailed([this, file](const FileDoesNotExistError& error) -> void {
+            removeFileFromBeingRead(file);
+            emit fileReadFailedFileDoesNotExist(file, error);
+          })
+          .onFailed([this, file](const FileError& error) -> void {
+            removeFileFromBeingRead(file);
+            emit fileReadFailed(file, error);
+          })
+          .onCanceled(
+              [this, file]() -> void { removeFileFromBeingRead(file); });
+  watcher->setFuture(future);
+  addFileToBeingRead(file);
+}
+
 void FileSystemService::setMaxFileSizeBytes(int maxFileSize) {
   if (_maxFileSizeBytes != maxFileSize) {
     _maxFileSizeBytes = maxFileSize;
@@ -71,6 +109,14 @@ void FileSystemService::setBlockSizeBytes(int blockSizeBytes) {
   }
 }
 
+void FileSystemService::setLargeFileThresholdBytes(
+    int largeFileThresholdBytes) {
+  if (_largeFileThresholdBytes != largeFileThresholdBytes) {
+    _largeFileThresholdBytes = largeFileThresholdBytes;
+    emit largeFileThresholdBytesChanged(largeFileThresholdBytes);
+  }
+}
+
 void FileSystemService::openFileReadable(QSharedPointer<QFile> file) const {
   ensureFileExists(file);
   if (file->isOpen()) {
@@ -1,6 +1,7 @@
 #ifndef _THEOIDE_MODELS_COMPILERSERVICE_
 #define _THEOIDE_MODELS_COMPILERSERVICE_
 
+#include <QByteArray>
 #include <QFuture>
 #include <QMap>
 #include <QMutex>
@@ -19,6 +20,7 @@ class CompilationTask {
   int revision() const { return _revision; }
   QMap<QString, QString> content() const { return _content; }
   QString mainTabName() const { return _mainTabName; }
+  QByteArray contentHash() const;
 
  private:
   QString _mainTabName;
@@ -28,14 +30,20 @@ class CompilationTask {
 
 class CompilationResult {
  public:
-  CompilationResult(const int revision, const Theo::CodegenResult& result)
-      : _revision(revision), _result(result) {}
-  int revision() const { return _revision; }
+  CompilationResult(const CompilationTask& task,
+                    const Theo::CodegenResult& result,
+                    const QByteArray& programHash)
+      : _task(task), _result(result), _programHash(programHash) {}
+  int revision() const { return _task.revision(); }
   Theo::CodegenResult result() const { return _result; }
+  QByteArray programHash() const { return _programHash; }
+  QString mainTabName() const { return _task.mainTabName(); }
+  CompilationTask task() const { return _task; }
 
  private:
-  int _revision;
+  CompilationTask _task;
   Theo::CodegenResult _result;
+  QByteArray _programHash;
 };
 
 using AsyncResult = QFuture<QSharedPointer<Theo::CodegenResult>>;
@@ -52,13 +60,13 @@ class CompilerService : public QObject {
   ~CompilerService();
   QSharedPointer<CompilationResult> result() const;
   QSharedPointer<CompilationResult> lastSuccessfulResult() const;
-  void compile(CompilationTask task);
+  QFuture<void> compile(CompilationTask task);
 
  public slots:
   void reset();
 
  signals:
-  void atLeastRevisionAvailable(int revision);
+  void compilationResultAvailable(QSharedPointer<CompilationResult> result);
   void resultChanged();
   void resetTriggered();
   void lastSuccessfulResultChanged();
@@ -74,7 +82,7 @@ class CompilerService : public QObject {
   QFuture<Theo::CodegenResult> compileAsync(const CompilationTask& task);
   std::map<std::string, std::string> convertContentToStdMap(
       const QMap<QString, QString>& map);
-  bool checkRevisionAlreadyCompiled(int revision);
+  bool checkRevisionAlreadyCompiled(const CompilationTask& task);
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <QObject>
 #include <QSharedPointer>
 #include <QString>
+#include <QStringList>
 #include <QtQmlIntegration>
 #include <functional>
 
@@ -29,6 +30,10 @@ class DialogService : public QObject {
   void addNoMainScriptSelected();
   void addCompilationFailed(const Theo::CodegenResult& result);
   void addExecutionFailedForInternalReason();
+  void addMemoryLimitExceeded(const qint64 memoryLimitBytes);
+  void addReplayFailed(const QString& reason);
+  void addHotSwapCompleted(const bool resumed,
+                           const QStringList& changedVariables);
 
   std::optional<QSharedPointer<MessageDialogDTO>> remove();
   bool isEmpty() const;
@@ -0,0 +1,85 @@
+#ifndef _THEOIDE_MODELS_EXECUTIONLOG_
+#define _THEOIDE_MODELS_EXECUTIONLOG_
+
+#include <QByteArray>
+#include <QFile>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QtTypes>
+#include <stdexcept>
+
+#include "VM/include/vm.hpp"
+
+class ExecutionLogFormatError : public std::runtime_error {
+ public:
+  ExecutionLogFormatError()
+      : std::runtime_error("The execution log is damaged or unsupported") {}
+  ~ExecutionLogFormatError() {}
+};
+
+class ExecutionLogOpenError : public std::runtime_error {
+ public:
+  ExecutionLogOpenError()
+      : std::runtime_error("The execution log could not be opened") {}
+  ~ExecutionLogOpenError() {}
+};
+
+enum class ExecutionLogRecordType : quint8 {
+  Checkpoint = 1,
+  Halt = 2,
+  End = 3,
+};
+
+struct ExecutionLogRecord {
+  ExecutionLogRecordType type;
+  qint32 callStackDepth;
+  qint64 instruction;
+  quint64 digest;
+};
+
+// Binary log of one execution. The header holds the program hash and the
+// breakpoint schedule and is followed by fixed size records, so a reader can
+// seek by index without parsing the records before it.
+class ExecutionLog {
+ public:
+  static constexpr qint64 CHECKPOINT_INSTRUCTIONS = 64 * 1024;
+  static constexpr qint64 RECORD_SIZE_BYTES = 24;
+  static quint64 digest(const Theo::VM::Activation::Data& variables,
+                        qint32 callStackDepth);
+};
+
+class ExecutionLogWriter {
+ public:
+  ExecutionLogWriter(const QString& fileName, const QByteArray& programHash,
+                     const QMap<QString, QSet<int>>& breakPoints);
+  ~ExecutionLogWriter();
+  void append(const ExecutionLogRecord& record);
+
+ private:
+  QFile _file;
+};
+
+class ExecutionLogReader {
+ public:
+  ExecutionLogReader(const QString& fileName);
+  ~ExecutionLogReader();
+  QByteArray programHash() const;
+  QMap<QString, QSet<int>> breakPoints() const;
+  qint64 recordCount() const;
+  ExecutionLogRecord recordAt(qint64 index) const;
+  qint64 indexAtOrAfter(qint64 instruction) const;
+  bool matches(const ExecutionLogRecord& record) const;
+
+ private:
+  QFile _file;
+  const uchar* _data = nullptr;
+  qint64 _size = 0;
+  qint64 _recordsOffset = 0;
+  QByteArray _programHash;
+  QMap<QString, QSet<int>> _breakPoints;
+
+  void readHeader();
+};
+
+#endif
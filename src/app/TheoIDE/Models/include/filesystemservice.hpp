@@ -10,6 +10,8 @@
 #include <QSharedPointer>
 #include <QtQmlIntegration>
 
+class PieceTable;
+
 class FileError : public std::exception {
  public:
   FileError(const QString &fileName) : _fileName(fileName) {}
@@ -48,6 +50,13 @@ class FileOpenReadableError : public FileError {
   }
 };
 
+class FileMapError : public FileError {
+ public:
+  FileMapError(const QString &fileName) : FileError(fileName) {
+    setMessage(QString("Unable to map file %1 into memory").arg(fileName));
+  }
+};
+
 class FileDoesNotExistError : public FileError {
  public:
   FileDoesNotExistError(const QString &fileName) : FileError(fileName) {
@@ -88,6 +97,9 @@ class FileSystemService : public QObject {
                  setMaxFileSizeBytes NOTIFY maxFileSizeBytesChanged)
   Q_PROPERTY(int blockSizeBytes READ blockSizeBytes WRITE setBlockSizeBytes
                  NOTIFY blockSizeBytesChanged)
+  Q_PROPERTY(int largeFileThresholdBytes READ largeFileThresholdBytes WRITE
+                 setLargeFileThresholdBytes NOTIFY
+                     largeFileThresholdBytesChanged)
   Q_PROPERTY(QList<QSharedPointer<QFile>> filesBeingRead READ filesBeingRead
                  NOTIFY filesBeingReadChanged)
   QML_ELEMENT
@@ -96,17 +108,22 @@ class FileSystemService : public QObject {
   ~FileSystemService();
   int maxFileSizeBytes() const;
   int blockSizeBytes() const;
+  int largeFileThresholdBytes() const;
   QList<QSharedPointer<QFile>> filesBeingRead() const;
   void readFile(QSharedPointer<QFile> file);
 
  public slots:
   void setMaxFileSizeBytes(int maxFileSizeBytes);
   void setBlockSizeBytes(int blockSizeBytes);
+  void setLargeFileThresholdBytes(int largeFileThresholdBytes);
 
  signals:
   void maxFileSizeBytesChanged(int maxFileSizeBytes);
   void blockSizeBytesChanged(int blockSizeBytes);
+  void largeFileThresholdBytesChanged(int largeFileThresholdBytes);
   void fileRead(QSharedPointer<QFile> file, QString content);
+  void largeFileRead(QSharedPointer<QFile> file,
+                     QSharedPointer<PieceTable> pieceTable);
   void fileReadFailed(QSharedPointer<QFile> file, const FileError &error);
   void fileReadFailedMaxReadSizeExceeded(
       QSharedPointer<QFile> file, const MaxReadFileSizeExceededError &error);
@@ -121,9 +138,11 @@ class FileSystemService : public QObject {
   mutable QMutex _filesBeingReadMutex;
   int _maxFileSizeBytes = 0;
   int _blockSizeBytes = 0;
+  int _largeFileThresholdBytes = 0;
   QList<QSharedPointer<QFile>> _filesBeingRead;
   QString readFileSync(QSharedPointer<QFile> file) const;
   QFuture<QString> readFileAsync(QSharedPointer<QFile> file) const;
+  void readLargeFile(QSharedPointer<QFile> file);
   void openFileReadable(QSharedPointer<QFile> file) const;
   void ensureFileExists(QSharedPointer<QFile> file) const;
   void addFileToBeingRead(QSharedPointer<QFile> file);
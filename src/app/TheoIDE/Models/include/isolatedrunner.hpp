@@ -0,0 +1,57 @@
+#ifndef _THEOIDE_MODELS_ISOLATEDRUNNER_
+#define _THEOIDE_MODELS_ISOLATEDRUNNER_
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QString>
+
+#include "runnerprotocol.hpp"
+#include "sharedmemoryring.hpp"
+
+// Runs a script in a separate TheoIDERunner process. Commands are sent over
+// a local socket, events come back through a shared memory ring, events that
+// do not fit into a slot of the ring are sent over the socket instead.
+class IsolatedRunner : public QObject {
+  Q_OBJECT
+ public:
+  IsolatedRunner(QObject* parent = nullptr);
+  ~IsolatedRunner();
+  bool isActive() const;
+  void start(const RunnerStartOptions& options);
+  void resume(bool stepping, int maxHaltDepth);
+  void setBreakPoint(const QString& fileName, int lineNumber, bool enabled);
+  void kill();
+
+ signals:
+  void liveVariablesAvailable(const RunnerState& state);
+  void halted(const RunnerState& state);
+  void finished(const RunnerState& state);
+  void failed(RunnerFailure failure);
+
+ protected slots:
+  void handleNewConnection();
+  void handleReadyRead();
+  void handleProcessFinished();
+
+ private:
+  QProcess _process;
+  QLocalServer _server;
+  QPointer<QLocalSocket> _socket;
+  QDataStream _stream;
+  SharedMemoryRing _ring;
+  QByteArray _pendingStart;
+  bool _isActive = false;
+
+  static QString runnerExecutable();
+  void send(const QByteArray& message);
+  void handleEvent(const QByteArray& payload);
+  void fail(RunnerFailure failure);
+  void shutDown();
+};
+
+#endif
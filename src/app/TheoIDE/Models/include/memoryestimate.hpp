@@ -0,0 +1,29 @@
+#ifndef _THEOIDE_MODELS_MEMORYESTIMATE_
+#define _THEOIDE_MODELS_MEMORYESTIMATE_
+
+#include <QList>
+#include <QtTypes>
+
+#include "VM/include/vm.hpp"
+
+// Estimates the memory held by the activation stack of a virtual machine.
+// Only the top activation runs, so the frames below it are measured once when
+// a call covers them and dropped again when it returns. A check then only
+// measures the top frame, whatever the depth of the stack.
+class MemoryEstimate {
+ public:
+  static constexpr int CHECK_INSTRUCTIONS = 4096;
+  // Approximates the allocation behind one entry of an activation's variable
+  // map on a 64-bit build: the node links and the allocator header.
+  static constexpr qint64 VARIABLE_NODE_OVERHEAD_BYTES = 48;
+
+  void track(Theo::VM& vm);
+  qint64 bytes(Theo::VM& vm) const;
+  static qint64 bytesOf(const Theo::VM::Activation& activation);
+
+ private:
+  QList<qint64> _coveredFrameBytes;
+  qint64 _coveredBytes = 0;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef _THEOIDE_MODELS_PIECETABLE_
+#define _THEOIDE_MODELS_PIECETABLE_
+
+#include <QByteArray>
+#include <QFile>
+#include <QIODevice>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+// Editable view of a memory mapped file. The file itself is never copied,
+// edits are appended to a separate buffer and the text is described by a
+// list of pieces pointing into either buffer. Line breaks of the mapped file
+// are indexed once with a checkpoint every LINE_INDEX_STRIDE lines, so
+// finding a line costs a binary search and a short scan. The end offset and
+// the line breaks up to the end of every piece are kept as prefix sums, so
+// the piece holding an offset or a line is found by binary search as well.
+class PieceTable {
+ public:
+  PieceTable(const QString& fileName);
+  ~PieceTable();
+  PieceTable(const PieceTable&) = delete;
+  PieceTable& operator=(const PieceTable&) = delete;
+
+  qint64 size() const;
+  qint64 lineCount() const;
+  QString lineAt(qint64 lineIndex) const;
+  void replaceLine(qint64 lineIndex, const QString& text);
+  void insert(qint64 offset, const QByteArray& text);
+  void remove(qint64 offset, qint64 length);
+  qint64 lineOffsetAt(qint64 lineIndex) const;
+  qint64 lineLengthAt(qint64 lineIndex) const;
+  QByteArray toByteArray() const;
+  bool writeTo(QIODevice* device) const;
+
+ private:
+  enum class Source : quint8 {
+    Original,
+    Added,
+  };
+  struct Piece {
+    Source source;
+    qint64 start;
+    qint64 length;
+    qint64 lineBreaks;
+  };
+  static constexpr qint64 LINE_INDEX_STRIDE = 256;
+
+  QFile _file;
+  const char* _original = nullptr;
+  qint64 _originalSize = 0;
+  QByteArray _added;
+  QList<Piece> _pieces;
+  QList<qint64> _pieceEnds;
+  QList<qint64> _pieceLineBreakEnds;
+  QList<qint64> _lineBreakCheckpoints;
+  qint64 _size = 0;
+  qint64 _lineBreaks = 0;
+
+  const char* dataOf(Source source) const;
+  void indexOriginalLineBreaks();
+  qint64 originalLineBreaksBefore(qint64 offset) const;
+  qint64 countLineBreaks(Source source, qint64 start, qint64 length) const;
+  qint64 findLineBreak(const Piece& piece, qint64 lineBreak) const;
+  qint64 pieceStart(qsizetype index) const;
+  qsizetype pieceAt(qint64 offset) const;
+  void updatePieceEnds(qsizetype first);
+  QByteArray bytesAt(qint64 offset, qint64 length) const;
+  qsizetype splitAt(qint64 offset);
+};
+
+#endif
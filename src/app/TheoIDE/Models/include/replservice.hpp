@@ -0,0 +1,60 @@
+#ifndef _THEOIDE_MODELS_REPLSERVICE_
+#define _THEOIDE_MODELS_REPLSERVICE_
+
+#include <QMap>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <QtQmlIntegration>
+#include <atomic>
+
+#include "virtualmachineservice.hpp"
+
+class ReplService : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(bool isEvaluating READ isEvaluating NOTIFY isEvaluatingChanged)
+  Q_PROPERTY(QMap<QString, int> variables READ variables NOTIFY
+                 variablesChanged)
+  Q_PROPERTY(int timeoutMs READ timeoutMs WRITE setTimeoutMs NOTIFY
+                 timeoutMsChanged)
+  Q_PROPERTY(qint64 memoryLimitBytes READ memoryLimitBytes WRITE
+                 setMemoryLimitBytes NOTIFY memoryLimitBytesChanged)
+  QML_ELEMENT
+ public:
+  ReplService(QObject* parent = nullptr);
+  ~ReplService();
+  bool isEvaluating() const;
+  QMap<QString, int> variables() const;
+  int timeoutMs() const;
+  qint64 memoryLimitBytes() const;
+
+  Q_INVOKABLE
+  void evaluate(const QString& snippet);
+  Q_INVOKABLE
+  void reset();
+
+ public slots:
+  void setTimeoutMs(int timeoutMs);
+  void setMemoryLimitBytes(qint64 memoryLimitBytes);
+
+ signals:
+  void isEvaluatingChanged();
+  void variablesChanged();
+  void timeoutMsChanged();
+  void memoryLimitBytesChanged();
+  void snippetEvaluated(const QString& snippet,
+                        const QMap<QString, int>& variables,
+                        const QString& error);
+
+ private:
+  QMap<QString, int> _variables;
+  bool _isEvaluating = false;
+  int _timeoutMs = 5000;
+  qint64 _memoryLimitBytes = 0;
+  QSharedPointer<std::atomic<bool>> _canceled;
+
+  void setIsEvaluating(bool isEvaluating);
+  void handleSnippetResult(const QString& snippet, const SweepResult& result);
+};
+
+#endif
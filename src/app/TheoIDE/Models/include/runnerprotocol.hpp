@@ -0,0 +1,60 @@
+#ifndef _THEOIDE_MODELS_RUNNERPROTOCOL_
+#define _THEOIDE_MODELS_RUNNERPROTOCOL_
+
+#include <QDataStream>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QtTypes>
+
+using RunnerFrames = QList<QMap<QString, int>>;
+
+enum class RunnerCommand : quint8 {
+  Start = 1,
+  Resume = 2,
+  SetBreakPoint = 3,
+};
+
+enum class RunnerMessage : quint8 {
+  EventsWritten = 1,
+  Event = 2,
+};
+
+enum class RunnerEvent : quint8 {
+  LiveVariables = 1,
+  Halted = 2,
+  Finished = 3,
+  Failed = 4,
+};
+
+enum class RunnerFailure : quint8 {
+  CompilationFailed = 1,
+  MemoryLimitExceeded = 2,
+  Internal = 3,
+};
+
+struct RunnerStartOptions {
+  QMap<QString, QString> files;
+  QString mainTabName;
+  QMap<QString, QSet<int>> breakPoints;
+  qint64 memoryLimitBytes = 0;
+  qint32 liveVariablesIntervalMs = 0;
+  bool stepping = false;
+};
+
+// Snapshot of a runner execution. Frames are ordered from the global frame
+// to the innermost call.
+struct RunnerState {
+  RunnerFrames frames;
+  qint64 executedInstructions = 0;
+  qint32 peakCallStackDepth = 0;
+  qint64 peakMemoryBytes = 0;
+};
+
+QDataStream& operator<<(QDataStream& stream, const RunnerStartOptions& options);
+QDataStream& operator>>(QDataStream& stream, RunnerStartOptions& options);
+QDataStream& operator<<(QDataStream& stream, const RunnerState& state);
+QDataStream& operator>>(QDataStream& stream, RunnerState& state);
+
+#endif
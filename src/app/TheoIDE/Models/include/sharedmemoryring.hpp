@@ -0,0 +1,39 @@
+#ifndef _THEOIDE_MODELS_SHAREDMEMORYRING_
+#define _THEOIDE_MODELS_SHAREDMEMORYRING_
+
+#include <QByteArray>
+#include <QList>
+#include <QSharedMemory>
+#include <QString>
+#include <QtTypes>
+
+// Ring of fixed size slots in a shared memory segment, written by one
+// process and read by another. Every written payload gets a sequence number,
+// a reader that falls more than a full ring behind loses the oldest payloads.
+class SharedMemoryRing {
+ public:
+  SharedMemoryRing();
+  ~SharedMemoryRing();
+  bool create(const QString& key, int slotCount, int slotSizeBytes);
+  bool attach(const QString& key);
+  void detach();
+  bool isAttached() const;
+  int maxPayloadSizeBytes() const;
+  bool write(const QByteArray& payload, quint64& sequence);
+  QList<QByteArray> readUntil(quint64 sequence);
+
+ private:
+  struct Header {
+    quint32 slotCount;
+    quint32 slotSizeBytes;
+    quint64 writeSequence;
+  };
+
+  QSharedMemory _memory;
+  quint64 _readSequence = 0;
+
+  Header* header() const;
+  char* slotAt(quint64 sequence) const;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _THEOIDE_MODELS_SNAPSHOTBUFFER_
+#define _THEOIDE_MODELS_SNAPSHOTBUFFER_
+
+#include <array>
+#include <atomic>
+
+// Lock-free handover of the latest value from one producer thread to one
+// consumer thread. The producer never waits and the consumer only sees the
+// most recent snapshot, older unread snapshots are overwritten. Values are
+// copy assigned in both directions so the storage of the slots is reused.
+template <typename T>
+class SnapshotBuffer {
+ public:
+  SnapshotBuffer() = default;
+  SnapshotBuffer(const SnapshotBuffer&) = delete;
+  SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+  void publish(const T& value) {
+    _slots[_writeIndex] = value;
+    const int previous =
+        _sharedIndex.exchange(_writeIndex | DIRTY, std::memory_order_acq_rel);
+    _writeIndex = previous & INDEX_MASK;
+  }
+
+  bool take(T& destination) {
+    if ((_sharedIndex.load(std::memory_order_acquire) & DIRTY) == 0) {
+      return false;
+    }
+    const int previous =
+        _sharedIndex.exchange(_readIndex, std::memory_order_acq_rel);
+    _readIndex = previous & INDEX_MASK;
+    destination = _slots[_readIndex];
+    return true;
+  }
+
+ private:
+  static constexpr int DIRTY = 0b100;
+  static constexpr int INDEX_MASK = 0b011;
+  std::array<T, 3> _slots;
+  int _writeIndex = 0;
+  std::atomic<int> _sharedIndex = 1;
+  int _readIndex = 2;
+};
+
+#endif
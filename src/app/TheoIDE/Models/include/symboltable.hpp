@@ -0,0 +1,23 @@
+#ifndef _THEOIDE_MODELS_SYMBOLTABLE_
+#define _THEOIDE_MODELS_SYMBOLTABLE_
+
+#include <QList>
+#include <QString>
+#include <string>
+#include <unordered_map>
+
+using SymbolId = int;
+
+class SymbolTable {
+ public:
+  SymbolId intern(const std::string& name);
+  QString nameOf(SymbolId id) const;
+  qsizetype size() const;
+  void clear();
+
+ private:
+  std::unordered_map<std::string, SymbolId> _ids;
+  QList<QString> _names;
+};
+
+#endif
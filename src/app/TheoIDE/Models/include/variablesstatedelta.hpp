@@ -0,0 +1,30 @@
+#ifndef _THEOIDE_MODELS_VARIABLESSTATEDELTA_
+#define _THEOIDE_MODELS_VARIABLESSTATEDELTA_
+
+#include <QList>
+#include <QMap>
+#include <QPair>
+
+#include "symboltable.hpp"
+
+using VariablesState = QMap<SymbolId, int>;
+using VariableEntry = QPair<SymbolId, int>;
+
+class VariablesStateDelta {
+ public:
+  VariablesStateDelta() = default;
+  VariablesStateDelta(const VariablesState& previous,
+                      const VariablesState& next);
+
+  const QList<VariableEntry>& added() const;
+  const QList<SymbolId>& removed() const;
+  const QList<VariableEntry>& changed() const;
+  bool isEmpty() const;
+
+ private:
+  QList<VariableEntry> _added;
+  QList<SymbolId> _removed;
+  QList<VariableEntry> _changed;
+};
+
+#endif
@@ -1,21 +1,45 @@
 #ifndef _THEOIDE_MODELS_VIRTUALMACHINESERVICE_
 #define _THEOIDE_MODELS_VIRTUALMACHINESERVICE_
 
+#include <QByteArray>
+#include <QCache>
 #include <QFuture>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
 #include <QMap>
 #include <QObject>
+#include <QPair>
+#include <QPointer>
 #include <QPromise>
 #include <QSet>
 #include <QSharedPointer>
 #include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
 #include <QtQmlIntegration>
+#include <atomic>
+#include <chrono>
 #include <exception>
+#include <limits>
+#include <optional>
 #include <stdexcept>
 
 #include "VM/include/program.hpp"
 #include "VM/include/vm.hpp"
+#include "compilerservice.hpp"
+#include "executionlog.hpp"
+#include "snapshotbuffer.hpp"
+#include "symboltable.hpp"
+#include "variablesstatedelta.hpp"
 
 using VMData = Theo::VM::Activation::Data;
+using LiveVariablesBuffer = SnapshotBuffer<VMData>;
+using VariableOverrides = QMap<QString, int>;
+// Start and length of the statement that replaces a variable's value in a
+// sweep, keyed by the variable name.
+using TopLevelAssignments = QHash<QString, QPair<qsizetype, qsizetype>>;
 
 class VirtualMachineIsNullError : public std::runtime_error {
  public:
@@ -31,12 +55,101 @@ class ActivationsAreEmptyError : public std::runtime_error {
   ~ActivationsAreEmptyError() {};
 };
 
+class MemoryLimitExceededError : public std::runtime_error {
+ public:
+  MemoryLimitExceededError()
+      : std::runtime_error("The memory limit of the execution was exceeded") {}
+  ~MemoryLimitExceededError() {}
+};
+
+class ReplayProgramMismatchError : public std::runtime_error {
+ public:
+  ReplayProgramMismatchError()
+      : std::runtime_error(
+            "The execution log was recorded for a different program") {}
+  ~ReplayProgramMismatchError() {}
+};
+
+class ReplayDivergedError : public std::runtime_error {
+ public:
+  ReplayDivergedError()
+      : std::runtime_error("The replay diverged from the recorded execution") {
+  }
+  ~ReplayDivergedError() {}
+};
+
+class IsolatedRunner;
+struct RunnerState;
+enum class RunnerFailure : quint8;
+struct ExecutionOptions;
+struct ExecutionCounters;
+struct SweepOptions;
+
+struct SweepResult {
+  int variantIndex = 0;
+  VariableOverrides overrides;
+  QMap<QString, int> variables;
+  bool succeeded = false;
+  QString error;
+};
+
+struct HotSwapReference {
+  QMap<QString, int> variables;
+  int callStackDepth = 0;
+};
+
+// How a debugging run reached one of its halts. A hot swap retraces these
+// steps in the new program, so it halts where the user left off.
+struct HaltStep {
+  bool stepping = false;
+  int maxHaltDepth = std::numeric_limits<int>::max();
+  QMap<QString, QSet<int>> breakPoints;
+};
+
+struct PooledVirtualMachine {
+  QByteArray programHash;
+  QSharedPointer<Theo::VM> virtualMachine;
+  QMap<QString, QSet<int>> appliedBreakPoints;
+};
+
 class VirtualMachineService : public QObject {
   Q_OBJECT
   Q_PROPERTY(bool isRunning READ isRunning NOTIFY isRunningChanged)
   Q_PROPERTY(bool isDebugging READ isDebugging NOTIFY isDebuggingChanged)
   Q_PROPERTY(QMap<QString, int> variablesState READ variablesState NOTIFY
                  variablesStateChanged)
+  Q_PROPERTY(
+      int callStackDepth READ callStackDepth NOTIFY callStackDepthChanged)
+  Q_PROPERTY(bool liveVariablesEnabled READ liveVariablesEnabled WRITE
+                 setLiveVariablesEnabled NOTIFY liveVariablesEnabledChanged)
+  Q_PROPERTY(int liveVariablesMaxRateHz READ liveVariablesMaxRateHz WRITE
+                 setLiveVariablesMaxRateHz NOTIFY liveVariablesMaxRateHzChanged)
+  Q_PROPERTY(int peakCallStackDepth READ peakCallStackDepth NOTIFY
+                 executionStatisticsChanged)
+  Q_PROPERTY(qint64 executedInstructions READ executedInstructions NOTIFY
+                 executionStatisticsChanged)
+  Q_PROPERTY(int haltCount READ haltCount NOTIFY executionStatisticsChanged)
+  Q_PROPERTY(qint64 memoryLimitBytes READ memoryLimitBytes WRITE
+                 setMemoryLimitBytes NOTIFY memoryLimitBytesChanged)
+  Q_PROPERTY(qint64 peakMemoryBytes READ peakMemoryBytes NOTIFY
+                 executionStatisticsChanged)
+  Q_PROPERTY(bool isSweeping READ isSweeping NOTIFY isSweepingChanged)
+  Q_PROPERTY(int sweepTimeoutMs READ sweepTimeoutMs WRITE setSweepTimeoutMs
+                 NOTIFY sweepTimeoutMsChanged)
+  Q_PROPERTY(bool executionCacheEnabled READ executionCacheEnabled WRITE
+                 setExecutionCacheEnabled NOTIFY executionCacheEnabledChanged)
+  Q_PROPERTY(bool lastResultFromCache READ lastResultFromCache NOTIFY
+                 lastResultFromCacheChanged)
+  Q_PROPERTY(QString recordingDirectory READ recordingDirectory WRITE
+                 setRecordingDirectory NOTIFY recordingDirectoryChanged)
+  Q_PROPERTY(bool isReplaying READ isReplaying NOTIFY isReplayingChanged)
+  Q_PROPERTY(int replayRecordCount READ replayRecordCount NOTIFY
+                 isReplayingChanged)
+  Q_PROPERTY(
+      int replayPosition READ replayPosition NOTIFY replayPositionChanged)
+  Q_PROPERTY(bool isolatedExecutionEnabled READ isolatedExecutionEnabled WRITE
+                 setIsolatedExecutionEnabled NOTIFY
+                     isolatedExecutionEnabledChanged)
   QML_ELEMENT
  public:
   VirtualMachineService(QObject* parent = nullptr);
@@ -45,10 +158,47 @@ class VirtualMachineService : public QObject {
   bool isDebugging() const;
   QList<int> getBreakpointsOfTab(const QString& tabName) const;
   QMap<QString, int> variablesState() const;
+  VariablesState variablesStateById() const;
+  int callStackDepth() const;
+  QMap<QString, int> frameVariablesAt(int frameIndex);
+  QString symbolName(SymbolId id) const;
+  bool liveVariablesEnabled() const;
+  int liveVariablesMaxRateHz() const;
+  int peakCallStackDepth() const;
+  qint64 executedInstructions() const;
+  int haltCount() const;
+  bool executionCacheEnabled() const;
+  bool lastResultFromCache() const;
+  qint64 memoryLimitBytes() const;
+  qint64 peakMemoryBytes() const;
+  bool isSweeping() const;
+  int sweepTimeoutMs() const;
+  QString recordingDirectory() const;
+  QString recordingPathOf(const QByteArray& programHash) const;
+  bool isReplaying() const;
+  int replayRecordCount() const;
+  int replayPosition() const;
+  void replay(const Theo::Program& program, const QByteArray& programHash,
+              const QString& logPath);
+  bool isolatedExecutionEnabled() const;
+  bool isRunningIsolated() const;
+  void executeIsolated(const CompilationTask& task);
+  void debugIsolated(const CompilationTask& task);
+  void hotSwapIsolated(const CompilationTask& task);
+  void sweep(const CompilationTask& task,
+             const QList<VariableOverrides>& variants);
+  void hotSwap(const Theo::Program& program,
+               const QByteArray& programHash = QByteArray());
+  static SweepResult executeSweepVariant(const CompilationTask& task,
+                                         int variantIndex,
+                                         const VariableOverrides& overrides,
+                                         const SweepOptions& options);
 
  public slots:
-  void execute(const Theo::Program& program);
-  void debug(const Theo::Program& program);
+  void execute(const Theo::Program& program,
+               const QByteArray& programHash = QByteArray());
+  void debug(const Theo::Program& program,
+             const QByteArray& programHash = QByteArray());
   void setBreakPointAt(const QString& tabName, const int lineNumber);
   void deleteBreakPointAt(const QString& tabName, const int lineNumber);
   void restart();
@@ -56,6 +206,18 @@ class VirtualMachineService : public QObject {
   void stopExecution();
   void stepNextBreakPoint();
   void stepNextPossibleBreakPoint();
+  void stepOver();
+  void stepOut();
+  void runToLine(const QString& tabName, int lineNumber);
+  void setLiveVariablesEnabled(bool enabled);
+  void setLiveVariablesMaxRateHz(int rateHz);
+  void setExecutionCacheEnabled(bool enabled);
+  void setMemoryLimitBytes(qint64 memoryLimitBytes);
+  void setSweepTimeoutMs(int sweepTimeoutMs);
+  void stopSweep();
+  void setRecordingDirectory(const QString& recordingDirectory);
+  void seekReplayRecord(int recordIndex);
+  void setIsolatedExecutionEnabled(bool enabled);
 
  signals:
   void executionCompleted();
@@ -63,34 +225,169 @@ class VirtualMachineService : public QObject {
   void isDebuggingChanged();
   void stopCalled();
   void variablesStateChanged();
+  void variablesStateUpdated(const VariablesStateDelta& delta);
+  void callStackDepthChanged();
+  void callStackChanged();
+  void executionHalted();
+  void liveVariablesEnabledChanged();
+  void liveVariablesMaxRateHzChanged();
+  void executionStatisticsChanged();
+  void executionCacheEnabledChanged();
+  void lastResultFromCacheChanged();
+  void memoryLimitBytesChanged();
+  void memoryLimitExceeded(qint64 memoryLimitBytes);
+  void isSweepingChanged();
+  void sweepTimeoutMsChanged();
+  void sweepStarted(int variantCount);
+  void sweepResultReady(const SweepResult& result);
+  void sweepFinished();
+  void hotSwapCompleted(bool resumed, const QStringList& changedVariables);
+  void recordingDirectoryChanged();
+  void isReplayingChanged();
+  void replayPositionChanged();
+  void replayFailed(const QString& reason);
+  void isolatedExecutionEnabledChanged();
   void executionFailedForInternalReason();
 
  protected slots:
   void deinitVirtualMachine();
+  void updateLiveVariables();
 
  private:
   QSharedPointer<Theo::VM> _virtualMachine;
+  QByteArray _programHash;
+  QMap<QString, QSet<int>> _appliedBreakPoints;
+  QFuture<VMData> _execution;
+  QList<PooledVirtualMachine> _virtualMachinePool;
   QMap<QString, QSet<int>> _breakPoints;
   bool _isDebugging = false;
-  QMap<QString, int> _variablesState;
+  SymbolTable _symbolTable;
+  VariablesState _variablesState;
+  int _callStackDepth = 0;
+  std::atomic<bool> _isExecuting = false;
+  bool _liveVariablesEnabled = false;
+  int _liveVariablesMaxRateHz = 10;
+  QSharedPointer<LiveVariablesBuffer> _liveVariables;
+  QTimer _liveVariablesTimer;
+  VMData _liveVariablesSnapshot;
+  QSharedPointer<ExecutionCounters> _executionCounters;
+  int _peakCallStackDepth = 0;
+  qint64 _executedInstructions = 0;
+  int _haltCount = 0;
+  bool _executionCacheEnabled = false;
+  bool _lastResultFromCache = false;
+  QCache<QByteArray, VMData> _executionCache;
+  qint64 _memoryLimitBytes = 0;
+  qint64 _peakMemoryBytes = 0;
+  QThreadPool _sweepThreadPool;
+  QPointer<QFutureWatcher<SweepResult>> _sweepWatcher;
+  QSharedPointer<std::atomic<bool>> _sweepCanceled;
+  int _sweepTimeoutMs = 5000;
+  QList<HaltStep> _haltSteps;
+  QList<HaltStep> _pendingHaltSteps;
+  std::optional<HotSwapReference> _hotSwapReference;
+  QString _recordingDirectory;
+  QSharedPointer<ExecutionLogWriter> _recording;
+  QSharedPointer<ExecutionLogReader> _replayLog;
+  int _replayPosition = -1;
+  qint64 _stopAtInstruction = -1;
+  bool _isolatedExecutionEnabled = false;
+  QPointer<IsolatedRunner> _isolatedRunner;
+  std::optional<CompilationTask> _isolatedTask;
+  QList<QMap<QString, int>> _isolatedFrames;
+  int _maxHaltDepth = std::numeric_limits<int>::max();
+  std::optional<QPair<QString, int>> _temporaryBreakPoint;
 
   void setIsDebugging(const bool isDebugging);
-  void initVirtualMachine(const Theo::Program& program);
+  void initVirtualMachine(const Theo::Program& program,
+                          const QByteArray& programHash);
+  QSharedPointer<Theo::VM> takePooledVirtualMachine(
+      const QByteArray& programHash);
+  void releaseVirtualMachine();
   void applyBreakPoints();
+  void applyBreakPoints(const QMap<QString, QSet<int>>& breakPoints);
+  void clearAppliedBreakPoints();
+  void setAppliedBreakPoint(const QString& fileName, int lineNumber,
+                            bool enabled);
   void resetVirtualMachine();
   void startVirtualMachine();
+  void retraceHaltStep();
+  void finishHotSwap();
   bool programEndReached() const;
   void cleanUpIfEndReached();
   QFuture<VMData> executeAsync();
   static void internalExecute(QPromise<VMData>& promise,
-                              QSharedPointer<Theo::VM> vm);
-  void setVariablesState(QMap<QString, int> variablesState);
-  void setVariablesState(VMData data);
+                              QSharedPointer<Theo::VM> vm,
+                              ExecutionOptions options);
+  static bool logExecution(QSharedPointer<Theo::VM> vm, qint64 instruction,
+                           bool stopped, const ExecutionOptions& options);
+  static void publishLiveVariables(QSharedPointer<Theo::VM> vm,
+                                   QSharedPointer<LiveVariablesBuffer> buffer);
+  static QMap<QString, QString> applyOverrides(
+      const CompilationTask& task, const VariableOverrides& overrides,
+      const TopLevelAssignments& assignments);
+  ExecutionOptions createExecutionOptions();
+  std::chrono::milliseconds liveVariablesInterval() const;
+  void startLiveVariablesTimer();
+  void setVariablesState(const VariablesState& variablesState);
+  bool executeFromCache(const QByteArray& programHash);
+  void cacheExecutionResult(const VMData& data);
+  void setLastResultFromCache(bool lastResultFromCache);
+  void startRecording();
+  void stopReplay();
+  void setReplayPosition(int replayPosition);
+  int nextReplayHalt() const;
+  IsolatedRunner* isolatedRunner();
+  void startIsolatedRun(const CompilationTask& task);
+  void startIsolatedRun(const CompilationTask& task, const HaltStep& step);
+  void resumeIsolatedRun(bool stepping,
+                         int maxHaltDepth = std::numeric_limits<int>::max());
+  void stepToDepth(int maxHaltDepth);
+  void clearTemporaryBreakPoint();
+  QMap<QString, QSet<int>> activeBreakPoints() const;
+  void setIsolatedBreakPoints(const QMap<QString, QSet<int>>& current,
+                              const QMap<QString, QSet<int>>& target);
+  void setIsolatedState(const RunnerState& state);
+  void handleIsolatedLiveVariables(const RunnerState& state);
+  void handleIsolatedHalted(const RunnerState& state);
+  void handleIsolatedFinished(const RunnerState& state);
+  void handleIsolatedFailed(RunnerFailure failure);
+  void resetExecutionStatistics();
+  void updateExecutionStatistics(bool halted = false);
+  void setVariablesState(const VMData& data);
+  void setCallStackDepth(int callStackDepth);
+  void updateCallStack();
   void handleActivationsAreEmptyError(const ActivationsAreEmptyError& error);
   void handleVirtualMachineIsNullError(const VirtualMachineIsNullError& error);
+  void handleMemoryLimitExceededError(const MemoryLimitExceededError& error);
+  void handleReplayDivergedError(const ReplayDivergedError& error);
   void handleExecutionError(const std::exception& error);
   void enableSteppingMode();
   void disableSteppingMode();
 };
 
+struct ExecutionOptions {
+  QSharedPointer<LiveVariablesBuffer> liveVariables;
+  std::chrono::milliseconds liveVariablesInterval;
+  QSharedPointer<ExecutionCounters> counters;
+  qint64 memoryLimitBytes;
+  QSharedPointer<ExecutionLogWriter> recording;
+  QSharedPointer<ExecutionLogReader> replayLog;
+  qint64 stopAtInstruction;
+  int maxHaltDepth;
+};
+
+struct SweepOptions {
+  std::chrono::milliseconds timeout;
+  qint64 memoryLimitBytes;
+  QSharedPointer<std::atomic<bool>> canceled;
+  TopLevelAssignments assignments;
+};
+
+struct ExecutionCounters {
+  std::atomic<qint64> executedInstructions = 0;
+  std::atomic<int> peakCallStackDepth = 0;
+  std::atomic<qint64> peakMemoryBytes = 0;
+};
+
 #endif
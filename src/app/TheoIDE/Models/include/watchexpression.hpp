@@ -0,0 +1,64 @@
+#ifndef _THEOIDE_MODELS_WATCHEXPRESSION_
+#define _THEOIDE_MODELS_WATCHEXPRESSION_
+
+#include <QCoreApplication>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <optional>
+#include <stdexcept>
+
+class WatchExpressionSyntaxError : public std::runtime_error {
+ public:
+  WatchExpressionSyntaxError()
+      : std::runtime_error("The watch expression is not well formed") {}
+  ~WatchExpressionSyntaxError() {}
+};
+
+struct WatchValue {
+  std::optional<int> value;
+  QString error;
+};
+
+// Integer expression over the variables of the halted frame, compiled once
+// into postfix bytecode so that repeated evaluation does not parse again.
+class WatchExpression {
+  Q_DECLARE_TR_FUNCTIONS(WatchExpression)
+
+ public:
+  static WatchExpression compile(const QString& source);
+  QString source() const;
+  const QSet<QString>& referencedVariables() const;
+  WatchValue evaluate(const QMap<QString, int>& variables) const;
+
+ private:
+  enum class OpCode : quint8 {
+    PushConstant,
+    PushVariable,
+    Negate,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+  };
+  struct Instruction {
+    OpCode opCode;
+    qint64 operand = 0;
+  };
+  class Parser;
+
+  QString _source;
+  QList<Instruction> _code;
+  QList<QString> _variableNames;
+  QSet<QString> _referencedVariables;
+};
+
+#endif
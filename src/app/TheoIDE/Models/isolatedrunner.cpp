@@ -0,0 +1,194 @@
+#include <QCoreApplication>
+#include <QStandardPaths>
+#include <QUuid>
+#include <QtLogging>
+
+#include "isolatedrunner.hpp"
+
+const int RING_SLOT_COUNT = 64;
+const int RING_SLOT_SIZE_BYTES = 64 * 1024;
+const QString RUNNER_EXECUTABLE_NAME = "TheoIDERunner";
+
+IsolatedRunner::IsolatedRunner(QObject* parent) : QObject(parent) {
+  connect(&_server, &QLocalServer::newConnection, this,
+          &IsolatedRunner::handleNewConnection);
+  connect(&_process, &QProcess::finished, this,
+          &IsolatedRunner::handleProcessFinished);
+  connect(&_process, &QProcess::errorOccurred, this,
+          [this](QProcess::ProcessError error) -> void {
+            if (error == QProcess::FailedToStart) {
+              qCritical() << "The runner process could not be started"
+                          << _process.errorString();
+              handleProcessFinished();
+            }
+          });
+}
+
+IsolatedRunner::~IsolatedRunner() { shutDown(); }
+
+bool IsolatedRunner::isActive() const { return _isActive; }
+
+QString IsolatedRunner::runnerExecutable() {
+  const QString executable = QStandardPaths::findExecutable(
+      RUNNER_EXECUTABLE_NAME, {QCoreApplication::applicationDirPath()});
+  if (!executable.isEmpty()) {
+    return executable;
+  }
+  return QStandardPaths::findExecutable(RUNNER_EXECUTABLE_NAME);
+}
+
+void IsolatedRunner::start(const RunnerStartOptions& options) {
+  shutDown();
+  _isActive = true;
+  const QString name =
+      QString("theoide-runner-%1")
+          .arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
+  if (!_server.listen(name) ||
+      !_ring.create(name, RING_SLOT_COUNT, RING_SLOT_SIZE_BYTES)) {
+    qCritical() << "Failed to set up the channels to the runner process"
+                << _server.errorString();
+    fail(RunnerFailure::Internal);
+    return;
+  }
+  QDataStream stream(&_pendingStart, QIODevice::WriteOnly);
+  stream << RunnerCommand::Start << options;
+  _process.start(runnerExecutable(), {name});
+}
+
+void IsolatedRunner::resume(bool stepping, int maxHaltDepth) {
+  QByteArray message;
+  QDataStream stream(&message, QIODevice::WriteOnly);
+  stream << RunnerCommand::Resume << stepping
+         << static_cast<qint32>(maxHaltDepth);
+  send(message);
+}
+
+void IsolatedRunner::setBreakPoint(const QString& fileName, int lineNumber,
+                                   bool enabled) {
+  QByteArray message;
+  QDataStream stream(&message, QIODevice::WriteOnly);
+  stream << RunnerCommand::SetBreakPoint << fileName
+         << static_cast<qint32>(lineNumber) << enabled;
+  send(message);
+}
+
+void IsolatedRunner::kill() { shutDown(); }
+
+void IsolatedRunner::send(const QByteArray& message) {
+  if (!_isActive || _socket.isNull()) {
+    return;
+  }
+  _stream << message;
+}
+
+void IsolatedRunner::handleNewConnection() {
+  QLocalSocket* const socket = _server.nextPendingConnection();
+  if (socket == nullptr) {
+    return;
+  }
+  if (!_isActive || !_socket.isNull()) {
+    socket->abort();
+    socket->deleteLater();
+    return;
+  }
+  _socket = QPointer(socket);
+  _stream.setDevice(socket);
+  connect(socket, &QLocalSocket::readyRead, this,
+          &IsolatedRunner::handleReadyRead);
+  _server.close();
+  send(_pendingStart);
+  _pendingStart.clear();
+}
+
+void IsolatedRunner::handleReadyRead() {
+  while (_isActive && !_socket.isNull()) {
+    _stream.startTransaction();
+    QByteArray message;
+    _stream >> message;
+    if (!_stream.commitTransaction()) {
+      return;
+    }
+    QDataStream messageStream(message);
+    RunnerMessage type;
+    messageStream >> type;
+    switch (type) {
+      case RunnerMessage::EventsWritten: {
+        quint64 sequence = 0;
+        messageStream >> sequence;
+        for (const QByteArray& payload : _ring.readUntil(sequence)) {
+          handleEvent(payload);
+        }
+        break;
+      }
+      case RunnerMessage::Event: {
+        QByteArray payload;
+        messageStream >> payload;
+        handleEvent(payload);
+        break;
+      }
+    }
+  }
+}
+
+void IsolatedRunner::handleEvent(const QByteArray& payload) {
+  if (!_isActive) {
+    return;
+  }
+  QDataStream stream(payload);
+  RunnerEvent event;
+  stream >> event;
+  if (event == RunnerEvent::Failed) {
+    RunnerFailure failure;
+    stream >> failure;
+    fail(failure);
+    return;
+  }
+  RunnerState state;
+  stream >> state;
+  switch (event) {
+    case RunnerEvent::LiveVariables:
+      emit liveVariablesAvailable(state);
+      return;
+    case RunnerEvent::Halted:
+      emit halted(state);
+      return;
+    case RunnerEvent::Finished:
+      shutDown();
+      emit finished(state);
+      return;
+    default:
+      return;
+  }
+}
+
+void IsolatedRunner::handleProcessFinished() {
+  if (!_isActive) {
+    return;
+  }
+  qWarning() << "The runner process exited unexpectedly with code"
+             << _process.exitCode();
+  fail(RunnerFailure::Internal);
+}
+
+void IsolatedRunner::fail(RunnerFailure failure) {
+  shutDown();
+  emit failed(failure);
+}
+
+void IsolatedRunner::shutDown() {
+  _isActive = false;
+  _pendingStart.clear();
+  if (!_socket.isNull()) {
+    disconnect(_socket, nullptr, this, nullptr);
+    _socket->abort();
+    _socket->deleteLater();
+    _socket.clear();
+  }
+  _stream.setDevice(nullptr);
+  _server.close();
+  if (_process.state() != QProcess::NotRunning) {
+    _process.kill();
+    _process.waitForFinished();
+  }
+  _ring.detach();
+}
@@ -0,0 +1,33 @@
+#include "memoryestimate.hpp"
+
+void MemoryEstimate::track(Theo::VM& vm) {
+  const auto& activations = vm.getActivations();
+  const qsizetype coveredCount =
+      activations.empty() ? 0 : static_cast<qsizetype>(activations.size()) - 1;
+  while (_coveredFrameBytes.size() > coveredCount) {
+    _coveredBytes -= _coveredFrameBytes.takeLast();
+  }
+  while (_coveredFrameBytes.size() < coveredCount) {
+    const qint64 frameBytes =
+        bytesOf(activations.at(_coveredFrameBytes.size()));
+    _coveredFrameBytes.append(frameBytes);
+    _coveredBytes += frameBytes;
+  }
+}
+
+qint64 MemoryEstimate::bytes(Theo::VM& vm) const {
+  const auto& activations = vm.getActivations();
+  if (activations.empty()) {
+    return _coveredBytes;
+  }
+  return _coveredBytes + bytesOf(activations.back());
+}
+
+qint64 MemoryEstimate::bytesOf(const Theo::VM::Activation& activation) {
+  qint64 bytes = sizeof(activation);
+  for (const auto& variable : activation.getActivationVariables()) {
+    bytes += VARIABLE_NODE_OVERHEAD_BYTES + sizeof(variable) +
+             variable.first.capacity();
+  }
+  return bytes;
+}
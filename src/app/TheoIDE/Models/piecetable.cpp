@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cstring>
+
+#include "filesystemservice.hpp"
+#include "piecetable.hpp"
+
+PieceTable::PieceTable(const QString& fileName) : _file(fileName) {
+  if (!_file.exists()) {
+    throw FileDoesNotExistError(fileName);
+  }
+  if (!_file.open(QIODevice::ReadOnly)) {
+    throw FileOpenReadableError(fileName);
+  }
+  _originalSize = _file.size();
+  if (_originalSize == 0) {
+    return;
+  }
+  _original = reinterpret_cast<const char*>(_file.map(0, _originalSize));
+  if (_original == nullptr) {
+    throw FileMapError(fileName);
+  }
+  indexOriginalLineBreaks();
+  _pieces.append(Piece{Source::Original, 0, _originalSize, _lineBreaks});
+  updatePieceEnds(0);
+  _size = _originalSize;
+}
+
+PieceTable::~PieceTable() {}
+
+qint64 PieceTable::size() const { return _size; }
+
+qint64 PieceTable::lineCount() const { return _lineBreaks + 1; }
+
+QString PieceTable::lineAt(qint64 lineIndex) const {
+  return QString::fromUtf8(
+      bytesAt(lineOffsetAt(lineIndex), lineLengthAt(lineIndex)));
+}
+
+qint64 PieceTable::lineOffsetAt(qint64 lineIndex) const {
+  if (lineIndex <= 0) {
+    return 0;
+  }
+  if (lineIndex > _lineBreaks) {
+    return _size;
+  }
+  const qint64 lineBreak = lineIndex - 1;
+  const qsizetype index =
+      std::upper_bound(_pieceLineBreakEnds.cbegin(),
+                       _pieceLineBreakEnds.cend(), lineBreak) -
+      _pieceLineBreakEnds.cbegin();
+  if (index == _pieces.size()) {
+    return _size;
+  }
+  const qint64 lineBreaksBefore =
+      index == 0 ? 0 : _pieceLineBreakEnds.at(index - 1);
+  return pieceStart(index) +
+         findLineBreak(_pieces.at(index), lineBreak - lineBreaksBefore) + 1;
+}
+
+qint64 PieceTable::lineLengthAt(qint64 lineIndex) const {
+  const qint64 start = lineOffsetAt(lineIndex);
+  if (lineIndex >= _lineBreaks) {
+    return _size - start;
+  }
+  qint64 length = lineOffsetAt(lineIndex + 1) - 1 - start;
+  if (length > 0 && bytesAt(start + length - 1, 1) == "\r") {
+    --length;
+  }
+  return length;
+}
+
+void PieceTable::replaceLine(qint64 lineIndex, const QString& text) {
+  const qint64 offset = lineOffsetAt(lineIndex);
+  remove(offset, lineLengthAt(lineIndex));
+  insert(offset, text.toUtf8());
+}
+
+void PieceTable::insert(qint64 offset, const QByteArray& text) {
+  if (text.isEmpty() || offset < 0 || offset > _size) {
+    return;
+  }
+  const qint64 start = _added.size();
+  _added.append(text);
+  const Piece piece{Source::Added, start, text.size(),
+                    countLineBreaks(Source::Added, start, text.size())};
+  const qsizetype index = splitAt(offset);
+  _pieces.insert(index, piece);
+  updatePieceEnds(index);
+  _size += piece.length;
+  _lineBreaks += piece.lineBreaks;
+}
+
+void PieceTable::remove(qint64 offset, qint64 length) {
+  if (length <= 0 || offset < 0 || offset + length > _size) {
+    return;
+  }
+  const qsizetype first = splitAt(offset);
+  const qsizetype last = splitAt(offset + length);
+  for (qsizetype i = first; i < last; ++i) {
+    _lineBreaks -= _pieces.at(i).lineBreaks;
+  }
+  _pieces.remove(first, last - first);
+  updatePieceEnds(first);
+  _size -= length;
+}
+
+QByteArray PieceTable::toByteArray() const { return bytesAt(0, _size); }
+
+bool PieceTable::writeTo(QIODevice* device) const {
+  for (const Piece& piece : _pieces) {
+    if (device->write(dataOf(piece.source) + piece.start, piece.length) !=
+        piece.length) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const char* PieceTable::dataOf(Source source) const {
+  return source == Source::Original ? _original : _added.constData();
+}
+
+void PieceTable::indexOriginalLineBreaks() {
+  const char* position = _original;
+  const char* const end = _original + _originalSize;
+  while (position < end) {
+    const void* lineBreak = std::memchr(position, '\n', end - position);
+    if (lineBreak == nullptr) {
+      break;
+    }
+    position = static_cast<const char*>(lineBreak) + 1;
+    ++_lineBreaks;
+    if (_lineBreaks % LINE_INDEX_STRIDE == 0) {
+      _lineBreakCheckpoints.append(position - _original);
+    }
+  }
+}
+
+qint64 PieceTable::originalLineBreaksBefore(qint64 offset) const {
+  const auto checkpoint =
+      std::upper_bound(_lineBreakCheckpoints.cbegin(),
+                       _lineBreakCheckpoints.cend(), offset);
+  const qint64 checkpointIndex = checkpoint - _lineBreakCheckpoints.cbegin();
+  const qint64 start =
+      checkpointIndex == 0 ? 0 : _lineBreakCheckpoints.at(checkpointIndex - 1);
+  return checkpointIndex * LINE_INDEX_STRIDE +
+         std::count(_original + start, _original + offset, '\n');
+}
+
+qint64 PieceTable::countLineBreaks(Source source, qint64 start,
+                                   qint64 length) const {
+  if (source == Source::Original) {
+    return originalLineBreaksBefore(start + length) -
+           originalLineBreaksBefore(start);
+  }
+  const char* const data = dataOf(source) + start;
+  return std::count(data, data + length, '\n');
+}
+
+qint64 PieceTable::findLineBreak(const Piece& piece, qint64 lineBreak) const {
+  const char* const data = dataOf(piece.source);
+  qint64 position = piece.start;
+  if (piece.source == Source::Original) {
+    const qint64 target = originalLineBreaksBefore(piece.start) + lineBreak;
+    const qint64 checkpointIndex = target / LINE_INDEX_STRIDE;
+    if (checkpointIndex > 0) {
+      position = qMax(position, _lineBreakCheckpoints.at(checkpointIndex - 1));
+    }
+    lineBreak = target - originalLineBreaksBefore(position);
+  }
+  const char* const end = data + piece.start + piece.length;
+  const char* current = data + position;
+  while (true) {
+    current = static_cast<const char*>(
+        std::memchr(current, '\n', end - current));
+    if (lineBreak == 0) {
+      return current - data - piece.start;
+    }
+    --lineBreak;
+    ++current;
+  }
+}
+
+qint64 PieceTable::pieceStart(qsizetype index) const {
+  return index == 0 ? 0 : _pieceEnds.at(index - 1);
+}
+
+qsizetype PieceTable::pieceAt(qint64 offset) const {
+  return std::upper_bound(_pieceEnds.cbegin(), _pieceEnds.cend(), offset) -
+         _pieceEnds.cbegin();
+}
+
+void PieceTable::updatePieceEnds(qsizetype first) {
+  _pieceEnds.resize(_pieces.size());
+  _pieceLineBreakEnds.resize(_pieces.size());
+  qint64 end = pieceStart(first);
+  qint64 lineBreakEnd = first == 0 ? 0 : _pieceLineBreakEnds.at(first - 1);
+  for (qsizetype i = first; i < _pieces.size(); ++i) {
+    end += _pieces.at(i).length;
+    lineBreakEnd += _pieces.at(i).lineBreaks;
+    _pieceEnds[i] = end;
+    _pieceLineBreakEnds[i] = lineBreakEnd;
+  }
+}
+
+QByteArray PieceTable::bytesAt(qint64 offset, qint64 length) const {
+  QByteArray bytes;
+  bytes.reserve(length);
+  for (qsizetype i = pieceAt(offset); i < _pieces.size() && length > 0; ++i) {
+    const Piece& piece = _pieces.at(i);
+    const qint64 localStart = offset - pieceStart(i);
+    const qint64 count = qMin(piece.length - localStart, length);
+    bytes.append(dataOf(piece.source) + piece.start + localStart, count);
+    offset += count;
+    length -= count;
+  }
+  return bytes;
+}
+
+qsizetype PieceTable::splitAt(qint64 offset) {
+  const qsizetype i = pieceAt(offset);
+  if (i == _pieces.size()) {
+    return i;
+  }
+  const qint64 pieceOffset = pieceStart(i);
+  if (offset == pieceOffset) {
+    return i;
+  }
+  const Piece piece = _pieces.at(i);
+  const qint64 leftLength = offset - pieceOffset;
+  const qint64 leftLineBreaks =
+      countLineBreaks(piece.source, piece.start, leftLength);
+  _pieces[i] = Piece{piece.source, piece.start, leftLength, leftLineBreaks};
+  _pieces.insert(i + 1, Piece{piece.source, piece.start + leftLength,
+                              piece.length - leftLength,
+                              piece.lineBreaks - leftLineBreaks});
+  updatePieceEnds(i);
+  return i + 1;
+}
@@ -0,0 +1,81 @@
+#include <QtConcurrentRun>
+#include <chrono>
+
+#include "replservice.hpp"
+
+const QString REPL_SNIPPET_NAME = "repl";
+
+ReplService::ReplService(QObject* parent) : QObject(parent) {}
+
+ReplService::~ReplService() {
+  if (_canceled) {
+    _canceled->store(true);
+  }
+}
+
+bool ReplService::isEvaluating() const { return _isEvaluating; }
+
+void ReplService::setIsEvaluating(bool isEvaluating) {
+  if (_isEvaluating != isEvaluating) {
+    _isEvaluating = isEvaluating;
+    emit isEvaluatingChanged();
+  }
+}
+
+QMap<QString, int> ReplService::variables() const { return _variables; }
+
+int ReplService::timeoutMs() const { return _timeoutMs; }
+
+void ReplService::setTimeoutMs(int timeoutMs) {
+  if (_timeoutMs != timeoutMs) {
+    _timeoutMs = timeoutMs;
+    emit timeoutMsChanged();
+  }
+}
+
+qint64 ReplService::memoryLimitBytes() const { return _memoryLimitBytes; }
+
+void ReplService::setMemoryLimitBytes(qint64 memoryLimitBytes) {
+  if (_memoryLimitBytes != memoryLimitBytes) {
+    _memoryLimitBytes = memoryLimitBytes;
+    emit memoryLimitBytesChanged();
+  }
+}
+
+void ReplService::evaluate(const QString& snippet) {
+  if (_isEvaluating || snippet.trimmed().isEmpty()) {
+    return;
+  }
+  setIsEvaluating(true);
+  _canceled = QSharedPointer<std::atomic<bool>>(new std::atomic<bool>());
+  const CompilationTask task(0, {{REPL_SNIPPET_NAME, snippet}},
+                             REPL_SNIPPET_NAME);
+  const SweepOptions options{std::chrono::milliseconds(_timeoutMs),
+                             _memoryLimitBytes, _canceled};
+  const VariableOverrides scope = _variables;
+  QtConcurrent::run([task, scope, options]() -> SweepResult {
+    return VirtualMachineService::executeSweepVariant(task, 0, scope, options);
+  }).then(this, [this, snippet](SweepResult result) -> void {
+    handleSnippetResult(snippet, result);
+  });
+}
+
+void ReplService::handleSnippetResult(const QString& snippet,
+                                      const SweepResult& result) {
+  setIsEvaluating(false);
+  if (!result.succeeded) {
+    emit snippetEvaluated(snippet, QMap<QString, int>(), result.error);
+    return;
+  }
+  _variables = result.variables;
+  emit variablesChanged();
+  emit snippetEvaluated(snippet, result.variables, QString());
+}
+
+void ReplService::reset() {
+  if (_canceled) {
+    _canceled->store(true);
+  }
+  _variables.clear();
+  emit variablesChanged();
+}
@@ -0,0 +1,24 @@
+#include "runnerprotocol.hpp"
+
+QDataStream& operator<<(QDataStream& stream,
+                        const RunnerStartOptions& options) {
+  return stream << options.files << options.mainTabName << options.breakPoints
+                << options.memoryLimitBytes << options.liveVariablesIntervalMs
+                << options.stepping;
+}
+
+QDataStream& operator>>(QDataStream& stream, RunnerStartOptions& options) {
+  return stream >> options.files >> options.mainTabName >>
+         options.breakPoints >> options.memoryLimitBytes >>
+         options.liveVariablesIntervalMs >> options.stepping;
+}
+
+QDataStream& operator<<(QDataStream& stream, const RunnerState& state) {
+  return stream << state.frames << state.executedInstructions
+                << state.peakCallStackDepth << state.peakMemoryBytes;
+}
+
+QDataStream& operator>>(QDataStream& stream, RunnerState& state) {
+  return stream >> state.frames >> state.executedInstructions >>
+         state.peakCallStackDepth >> state.peakMemoryBytes;
+}
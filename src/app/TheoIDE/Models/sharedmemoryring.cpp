@@ -0,0 +1,100 @@
+#include <cstring>
+
+#include "sharedmemoryring.hpp"
+
+SharedMemoryRing::SharedMemoryRing() {}
+
+SharedMemoryRing::~SharedMemoryRing() { detach(); }
+
+bool SharedMemoryRing::create(const QString& key, int slotCount,
+                              int slotSizeBytes) {
+  detach();
+  _memory.setNativeKey(QSharedMemory::platformSafeKey(key));
+  const qsizetype size = sizeof(Header) +
+                         static_cast<qsizetype>(slotCount) * slotSizeBytes;
+  if (!_memory.create(size)) {
+    return false;
+  }
+  _memory.lock();
+  Header* const ringHeader = header();
+  ringHeader->slotCount = static_cast<quint32>(slotCount);
+  ringHeader->slotSizeBytes = static_cast<quint32>(slotSizeBytes);
+  ringHeader->writeSequence = 0;
+  _memory.unlock();
+  _readSequence = 0;
+  return true;
+}
+
+bool SharedMemoryRing::attach(const QString& key) {
+  detach();
+  _memory.setNativeKey(QSharedMemory::platformSafeKey(key));
+  if (!_memory.attach()) {
+    return false;
+  }
+  _memory.lock();
+  _readSequence = header()->writeSequence;
+  _memory.unlock();
+  return true;
+}
+
+void SharedMemoryRing::detach() {
+  if (_memory.isAttached()) {
+    _memory.detach();
+  }
+}
+
+bool SharedMemoryRing::isAttached() const { return _memory.isAttached(); }
+
+int SharedMemoryRing::maxPayloadSizeBytes() const {
+  if (!_memory.isAttached()) {
+    return 0;
+  }
+  return static_cast<int>(header()->slotSizeBytes - sizeof(quint32));
+}
+
+bool SharedMemoryRing::write(const QByteArray& payload, quint64& sequence) {
+  if (payload.size() > maxPayloadSizeBytes()) {
+    return false;
+  }
+  _memory.lock();
+  Header* const ringHeader = header();
+  char* const slot = slotAt(ringHeader->writeSequence);
+  const quint32 length = static_cast<quint32>(payload.size());
+  std::memcpy(slot, &length, sizeof(length));
+  std::memcpy(slot + sizeof(length), payload.constData(), payload.size());
+  sequence = ++ringHeader->writeSequence;
+  _memory.unlock();
+  return true;
+}
+
+QList<QByteArray> SharedMemoryRing::readUntil(quint64 sequence) {
+  QList<QByteArray> payloads;
+  if (!_memory.isAttached()) {
+    return payloads;
+  }
+  _memory.lock();
+  const Header* const ringHeader = header();
+  const quint64 last = qMin(sequence, ringHeader->writeSequence);
+  if (last > _readSequence + ringHeader->slotCount) {
+    _readSequence = last - ringHeader->slotCount;
+  }
+  for (; _readSequence < last; ++_readSequence) {
+    const char* const slot = slotAt(_readSequence);
+    quint32 length = 0;
+    std::memcpy(&length, slot, sizeof(length));
+    payloads.append(QByteArray(slot + sizeof(length), length));
+  }
+  _memory.unlock();
+  return payloads;
+}
+
+SharedMemoryRing::Header* SharedMemoryRing::header() const {
+  return static_cast<Header*>(const_cast<void*>(_memory.constData()));
+}
+
+char* SharedMemoryRing::slotAt(quint64 sequence) const {
+  const Header* const ringHeader = header();
+  char* const firstSlot = reinterpret_cast<char*>(header()) + sizeof(Header);
+  return firstSlot + (sequence % ringHeader->slotCount) *
+                     static_cast<quint64>(ringHeader->slotSizeBytes);
+}
@@ -0,0 +1,26 @@
+#include "symboltable.hpp"
+
+SymbolId SymbolTable::intern(const std::string& name) {
+  const auto iterator = _ids.find(name);
+  if (iterator != _ids.end()) {
+    return iterator->second;
+  }
+  const SymbolId id = static_cast<SymbolId>(_names.size());
+  _ids.emplace(name, id);
+  _names.append(QString::fromStdString(name));
+  return id;
+}
+
+QString SymbolTable::nameOf(SymbolId id) const {
+  if (id < 0 || id >= _names.size()) {
+    return QString();
+  }
+  return _names.at(id);
+}
+
+qsizetype SymbolTable::size() const { return _names.size(); }
+
+void SymbolTable::clear() {
+  _ids.clear();
+  _names.clear();
+}
@@ -0,0 +1,46 @@
+#include "variablesstatedelta.hpp"
+
+VariablesStateDelta::VariablesStateDelta(const VariablesState& previous,
+                                         const VariablesState& next) {
+  auto previousIterator = previous.constBegin();
+  auto nextIterator = next.constBegin();
+  while (previousIterator != previous.constEnd() &&
+         nextIterator != next.constEnd()) {
+    if (previousIterator.key() < nextIterator.key()) {
+      _removed.append(previousIterator.key());
+      ++previousIterator;
+    } else if (nextIterator.key() < previousIterator.key()) {
+      _added.append(VariableEntry(nextIterator.key(), nextIterator.value()));
+      ++nextIterator;
+    } else {
+      if (previousIterator.value() != nextIterator.value()) {
+        _changed.append(
+            VariableEntry(nextIterator.key(), nextIterator.value()));
+      }
+      ++previousIterator;
+      ++nextIterator;
+    }
+  }
+  for (; previousIterator != previous.constEnd(); ++previousIterator) {
+    _removed.append(previousIterator.key());
+  }
+  for (; nextIterator != next.constEnd(); ++nextIterator) {
+    _added.append(VariableEntry(nextIterator.key(), nextIterator.value()));
+  }
+}
+
+const QList<VariableEntry>& VariablesStateDelta::added() const {
+  return _added;
+}
+
+const QList<SymbolId>& VariablesStateDelta::removed() const {
+  return _removed;
+}
+
+const QList<VariableEntry>& VariablesStateDelta::changed() const {
+  return _changed;
+}
+
+bool VariablesStateDelta::isEmpty() const {
+  return _added.isEmpty() && _removed.isEmpty() && _changed.isEmpty();
+}
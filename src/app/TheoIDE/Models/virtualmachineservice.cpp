@@ -1,56 +1,369 @@
 #include <qtpreprocessorsupport.h>
 
+#include <QDir>
 #include <QFutureWatcher>
+#include <QUrl>
+#include <QtConcurrentMap>
 #include <QtConcurrentRun>
 #include <QtLogging>
+#include <algorithm>
 #include <exception>
+#include <limits>
+#include <map>
+#include <ranges>
+#include <utility>
 
+#include "compiler.hpp"
+#include "isolatedrunner.hpp"
+#include "memoryestimate.hpp"
 #include "virtualmachineservice.hpp"
 
+const int LIVE_VARIABLES_CHECK_INSTRUCTIONS = 1024;
+const int SWEEP_CHECK_INSTRUCTIONS = 256;
+const int VIRTUAL_MACHINE_POOL_SIZE = 4;
+const int EXECUTION_CACHE_MAX_VARIABLES = 64 * 1024;
+
+static QMap<QString, int> convertVariables(const VMData& data) {
+  QMap<QString, int> variables;
+  for (const auto& line : data) {
+    variables.insert(QString::fromStdString(line.first), line.second);
+  }
+  return variables;
+}
+
+// Finds the first assignment to each variable outside of any DO or THEN block,
+// which is where a script initialises its constants. The source is split into
+// tokens once, so names, keywords and the := operator are only matched as
+// whole tokens.
+static TopLevelAssignments findTopLevelAssignments(const QString& content) {
+  enum class TokenType { Word, Assign, End, Other };
+  struct Token {
+    TokenType type;
+    qsizetype start;
+    qsizetype length;
+  };
+  QList<Token> tokens;
+  const qsizetype size = content.size();
+  qsizetype position = 0;
+  while (position < size) {
+    const QChar character = content.at(position);
+    if (character.isSpace()) {
+      ++position;
+    } else if (character.isLetterOrNumber() || character == '_') {
+      const qsizetype start = position;
+      while (position < size && (content.at(position).isLetterOrNumber() ||
+                                 content.at(position) == '_')) {
+        ++position;
+      }
+      tokens.append(Token{TokenType::Word, start, position - start});
+    } else if (character == ':' && position + 1 < size &&
+               content.at(position + 1) == '=') {
+      tokens.append(Token{TokenType::Assign, position, 2});
+      position += 2;
+    } else {
+      tokens.append(Token{
+          character == ';' ? TokenType::End : TokenType::Other, position, 1});
+      ++position;
+    }
+  }
+
+  TopLevelAssignments assignments;
+  int depth = 0;
+  for (qsizetype index = 0; index < tokens.size(); ++index) {
+    const Token& token = tokens.at(index);
+    if (token.type != TokenType::Word) {
+      continue;
+    }
+    const QStringView word =
+        QStringView(content).sliced(token.start, token.length);
+    if (word == u"DO" || word == u"THEN") {
+      ++depth;
+    } else if (word == u"END") {
+      depth = std::max(0, depth - 1);
+    } else if (depth == 0 && index + 1 < tokens.size() &&
+               tokens.at(index + 1).type == TokenType::Assign) {
+      qsizetype end = index + 2;
+      while (end < tokens.size() && tokens.at(end).type != TokenType::End) {
+        ++end;
+      }
+      if (end == tokens.size()) {
+        break;
+      }
+      const QString name = word.toString();
+      if (!assignments.contains(name)) {
+        const Token& statementEnd = tokens.at(end);
+        assignments.insert(
+            name, qMakePair(token.start, statementEnd.start +
+                                             statementEnd.length -
+                                             token.start));
+      }
+      index = end;
+    }
+  }
+  return assignments;
+}
+
 VirtualMachineService::VirtualMachineService(QObject* parent)
-    : QObject(parent) {}
+    : QObject(parent),
+      _executionCounters(new ExecutionCounters()),
+      _executionCache(EXECUTION_CACHE_MAX_VARIABLES) {
+  connect(&_liveVariablesTimer, &QTimer::timeout, this,
+          &VirtualMachineService::updateLiveVariables);
+}
 
-VirtualMachineService::~VirtualMachineService() {}
+VirtualMachineService::~VirtualMachineService() {
+  stopSweep();
+  _sweepThreadPool.waitForDone();
+}
 
-void VirtualMachineService::execute(const Theo::Program& program) {
-  initVirtualMachine(program);
+void VirtualMachineService::execute(const Theo::Program& program,
+                                    const QByteArray& programHash) {
+  if (executeFromCache(programHash)) {
+    return;
+  }
+  setLastResultFromCache(false);
+  initVirtualMachine(program, programHash);
+  clearAppliedBreakPoints();
+  startRecording();
   startVirtualMachine();
 }
 
-void VirtualMachineService::debug(const Theo::Program& program) {
+void VirtualMachineService::debug(const Theo::Program& program,
+                                  const QByteArray& programHash) {
+  setLastResultFromCache(false);
   setIsDebugging(true);
-  initVirtualMachine(program);
+  initVirtualMachine(program, programHash);
   applyBreakPoints();
+  startRecording();
   startVirtualMachine();
 }
 
+void VirtualMachineService::replay(const Theo::Program& program,
+                                   const QByteArray& programHash,
+                                   const QString& logPath) {
+  QSharedPointer<ExecutionLogReader> replayLog;
+  try {
+    replayLog =
+        QSharedPointer<ExecutionLogReader>(new ExecutionLogReader(logPath));
+    if (replayLog->recordCount() == 0) {
+      throw ExecutionLogFormatError();
+    }
+    if (replayLog->programHash() != programHash) {
+      throw ReplayProgramMismatchError();
+    }
+  } catch (const std::runtime_error& error) {
+    qWarning() << "Replay of" << logPath << "failed:" << error.what();
+    emit replayFailed(QString::fromUtf8(error.what()));
+    emit executionCompleted();
+    return;
+  }
+  setLastResultFromCache(false);
+  setIsDebugging(true);
+  initVirtualMachine(program, programHash);
+  _replayLog = replayLog;
+  clearAppliedBreakPoints();
+  const QMap<QString, QSet<int>> breakPoints = _replayLog->breakPoints();
+  for (const auto& file : breakPoints.asKeyValueRange()) {
+    for (const int lineNumber : file.second) {
+      setAppliedBreakPoint(file.first, lineNumber, true);
+    }
+  }
+  emit isReplayingChanged();
+  seekReplayRecord(nextReplayHalt());
+}
+
 void VirtualMachineService::restart() {
+  if (isRunningIsolated() && _isolatedTask) {
+    startIsolatedRun(*_isolatedTask);
+    return;
+  }
   resetVirtualMachine();
+  resetExecutionStatistics();
+  _haltSteps.clear();
+  startRecording();
   startVirtualMachine();
 }
 
 void VirtualMachineService::restartDebug() {
+  if (isRunningIsolated() && _isolatedTask) {
+    startIsolatedRun(*_isolatedTask);
+    return;
+  }
   resetVirtualMachine();
+  resetExecutionStatistics();
+  _haltSteps.clear();
+  if (!_replayLog.isNull()) {
+    setReplayPosition(-1);
+    seekReplayRecord(nextReplayHalt());
+    return;
+  }
   applyBreakPoints();
+  startRecording();
+  startVirtualMachine();
+}
+
+void VirtualMachineService::hotSwap(const Theo::Program& program,
+                                    const QByteArray& programHash) {
+  if (!isRunning() || !_isDebugging || _isExecuting) {
+    return;
+  }
+  if (_haltSteps.isEmpty()) {
+    return;
+  }
+  const QList<HaltStep> haltSteps = _haltSteps;
+  _hotSwapReference = HotSwapReference{variablesState(), _callStackDepth};
+  initVirtualMachine(program, programHash);
+  _pendingHaltSteps = haltSteps;
+  retraceHaltStep();
+}
+
+void VirtualMachineService::retraceHaltStep() {
+  const HaltStep step = _pendingHaltSteps.takeFirst();
+  if (isRunningIsolated()) {
+    setIsolatedBreakPoints(_haltSteps.last().breakPoints, step.breakPoints);
+    _haltSteps.append(step);
+    _isExecuting = true;
+    _isolatedRunner->resume(step.stepping, step.maxHaltDepth);
+    return;
+  }
+  applyBreakPoints(step.breakPoints);
+  _virtualMachine->setSteppingMode(step.stepping);
+  _maxHaltDepth = step.maxHaltDepth;
   startVirtualMachine();
 }
 
+void VirtualMachineService::finishHotSwap() {
+  if (!_hotSwapReference) {
+    return;
+  }
+  const HotSwapReference reference = *_hotSwapReference;
+  _hotSwapReference.reset();
+  _pendingHaltSteps.clear();
+  const bool resumed = !programEndReached() &&
+                       reference.callStackDepth == _callStackDepth;
+  const QMap<QString, int> variables = variablesState();
+  QStringList changedVariables;
+  for (const auto& variable : reference.variables.asKeyValueRange()) {
+    const auto current = variables.constFind(variable.first);
+    if (current == variables.constEnd() || current.value() != variable.second) {
+      changedVariables.append(variable.first);
+    }
+  }
+  emit hotSwapCompleted(resumed, changedVariables);
+}
+
 QFuture<VMData> VirtualMachineService::executeAsync() {
   return QtConcurrent::run(&VirtualMachineService::internalExecute,
-                           _virtualMachine);
+                           _virtualMachine, createExecutionOptions());
+}
+
+ExecutionOptions VirtualMachineService::createExecutionOptions() {
+  _liveVariables.clear();
+  if (_liveVariablesEnabled && !_isDebugging) {
+    _liveVariables =
+        QSharedPointer<LiveVariablesBuffer>(new LiveVariablesBuffer());
+  }
+  return ExecutionOptions{_liveVariables,
+                          liveVariablesInterval(),
+                          _executionCounters,
+                          _memoryLimitBytes,
+                          _recording,
+                          _replayLog,
+                          std::exchange(_stopAtInstruction, -1),
+                          std::exchange(_maxHaltDepth,
+                                        std::numeric_limits<int>::max())};
 }
 
 void VirtualMachineService::internalExecute(QPromise<VMData>& promise,
-                                            QSharedPointer<Theo::VM> vm) {
+                                            QSharedPointer<Theo::VM> vm,
+                                            ExecutionOptions options) {
   if (vm.isNull()) {
     promise.setException(std::make_exception_ptr(VirtualMachineIsNullError()));
     return;
   }
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point nextLiveVariablesUpdate =
+      Clock::now() + options.liveVariablesInterval;
+  int instructionsUntilCheck = LIVE_VARIABLES_CHECK_INSTRUCTIONS;
+  int instructionsUntilMemoryCheck = 0;
+  MemoryEstimate memoryEstimate;
+  ExecutionCounters& counters = *options.counters;
+  const bool stepsToDepth =
+      options.maxHaltDepth != std::numeric_limits<int>::max();
+  // The counters are shared with the main thread. They are kept in locals and
+  // only published at the check points and when the execution stops, so the
+  // loop does not store to shared cache lines on every instruction.
+  qint64 instruction =
+      counters.executedInstructions.load(std::memory_order_relaxed);
+  int peakCallStackDepth =
+      counters.peakCallStackDepth.load(std::memory_order_relaxed);
+  const auto publishCounters = [&counters, &instruction,
+                                &peakCallStackDepth]() -> void {
+    counters.executedInstructions.store(instruction, std::memory_order_relaxed);
+    counters.peakCallStackDepth.store(peakCallStackDepth,
+                                      std::memory_order_relaxed);
+  };
   while (!promise.isCanceled()) {
     promise.suspendIfRequested();
+    const bool stepped = stepsToDepth && vm->isSteppingModeEnabled();
     const bool shouldStop = vm->executeSingle();
-    if (shouldStop) {
-      auto activations = vm->getActivations();
+    ++instruction;
+    const int callStackDepth = static_cast<int>(vm->getActivations().size());
+    peakCallStackDepth = std::max(peakCallStackDepth, callStackDepth);
+    bool haltTooDeep = false;
+    if (stepsToDepth) {
+      // Stepping is paused inside deeper calls, so only their breakpoints
+      // halt there.
+      const bool stepsHere = callStackDepth <= options.maxHaltDepth;
+      if (vm->isSteppingModeEnabled() != stepsHere) {
+        vm->setSteppingMode(stepsHere);
+      }
+      haltTooDeep = stepped && !stepsHere;
+    }
+    memoryEstimate.track(*vm);
+    if (--instructionsUntilMemoryCheck <= 0 || shouldStop) {
+      instructionsUntilMemoryCheck = MemoryEstimate::CHECK_INSTRUCTIONS;
+      publishCounters();
+      const qint64 memoryBytes = memoryEstimate.bytes(*vm);
+      if (memoryBytes >
+          counters.peakMemoryBytes.load(std::memory_order_relaxed)) {
+        counters.peakMemoryBytes.store(memoryBytes, std::memory_order_relaxed);
+      }
+      if (options.memoryLimitBytes > 0 &&
+          memoryBytes > options.memoryLimitBytes) {
+        promise.setException(
+            std::make_exception_ptr(MemoryLimitExceededError()));
+        return;
+      }
+    }
+    if (--instructionsUntilCheck == 0) {
+      instructionsUntilCheck = LIVE_VARIABLES_CHECK_INSTRUCTIONS;
+      publishCounters();
+      if (options.liveVariables) {
+        const Clock::time_point now = Clock::now();
+        if (now >= nextLiveVariablesUpdate) {
+          nextLiveVariablesUpdate = now + options.liveVariablesInterval;
+          publishLiveVariables(vm, options.liveVariables);
+        }
+      }
+    }
+    const bool seeking = options.stopAtInstruction >= 0;
+    const bool seekReached = instruction == options.stopAtInstruction;
+    const bool skipHalt = shouldStop && !seekReached && !vm->isDone() &&
+                          (haltTooDeep || seeking);
+    const bool stopped = (shouldStop && !skipHalt) || seekReached;
+    if ((stopped || instruction % ExecutionLog::CHECKPOINT_INSTRUCTIONS == 0) &&
+        !logExecution(vm, instruction, stopped, options)) {
+      publishCounters();
+      promise.setException(std::make_exception_ptr(ReplayDivergedError()));
+      return;
+    }
+    if (skipHalt) {
+      continue;
+    }
+    if (stopped) {
+      publishCounters();
+      const auto& activations = vm->getActivations();
       if (activations.empty()) {
         promise.setException(
             std::make_exception_ptr(ActivationsAreEmptyError()));
@@ -60,16 +373,67 @@ void VirtualMachineService::internalExecute(QPromise<VMData>& promise,
       return;
     }
   }
+  publishCounters();
+}
+
+bool VirtualMachineService::logExecution(QSharedPointer<Theo::VM> vm,
+                                         qint64 instruction, bool stopped,
+                                         const ExecutionOptions& options) {
+  if (options.recording.isNull() && options.replayLog.isNull()) {
+    return true;
+  }
+  const auto& activations = vm->getActivations();
+  const qint32 callStackDepth = static_cast<qint32>(activations.size());
+  ExecutionLogRecordType type = ExecutionLogRecordType::Checkpoint;
+  if (stopped) {
+    type = vm->isDone() ? ExecutionLogRecordType::End
+                        : ExecutionLogRecordType::Halt;
+  }
+  const ExecutionLogRecord record{
+      type, callStackDepth, instruction,
+      activations.empty()
+          ? 0
+          : ExecutionLog::digest(activations.back().getActivationVariables(),
+                                 callStackDepth)};
+  if (options.recording) {
+    options.recording->append(record);
+    return true;
+  }
+  return options.replayLog->matches(record);
+}
+
+void VirtualMachineService::publishLiveVariables(
+    QSharedPointer<Theo::VM> vm, QSharedPointer<LiveVariablesBuffer> buffer) {
+  const auto& activations = vm->getActivations();
+  if (activations.empty()) {
+    return;
+  }
+  buffer->publish(activations.back().getActivationVariables());
 }
 
 void VirtualMachineService::deinitVirtualMachine() {
-  _virtualMachine.clear();
+  _isExecuting = false;
+  _hotSwapReference.reset();
+  _pendingHaltSteps.clear();
+  _temporaryBreakPoint.reset();
+  _recording.clear();
+  stopReplay();
+  if (!_isolatedRunner.isNull()) {
+    _isolatedRunner->kill();
+  }
+  _isolatedFrames.clear();
+  releaseVirtualMachine();
+  setCallStackDepth(0);
+  emit callStackChanged();
   emit isRunningChanged();
   setIsDebugging(false);
   emit executionCompleted();
 }
 
 bool VirtualMachineService::programEndReached() const {
+  if (isRunningIsolated()) {
+    return false;
+  }
   if (_virtualMachine.isNull()) {
     return true;
   }
@@ -91,23 +455,54 @@ void VirtualMachineService::startVirtualMachine() {
           &VirtualMachineService::deinitVirtualMachine);
   connect(this, &VirtualMachineService::stopCalled, watcher,
           &QFutureWatcher<void>::cancel);
+  if (_isDebugging && _replayLog.isNull()) {
+    _haltSteps.append(HaltStep{_virtualMachine->isSteppingModeEnabled(),
+                               _maxHaltDepth, _appliedBreakPoints});
+  }
+  _isExecuting = true;
+  _execution = executeAsync();
   const QFuture future =
-      executeAsync()
-          .then([this](VMData data) -> void {
-            setVariablesState(data);
-            disableSteppingMode();
-            cleanUpIfEndReached();
-          })
+      _execution
+          .then(this,
+                [this](VMData data) -> void {
+                  _isExecuting = false;
+                  if (!_pendingHaltSteps.isEmpty() && !programEndReached()) {
+                    retraceHaltStep();
+                    return;
+                  }
+                  setVariablesState(data);
+                  updateCallStack();
+                  updateExecutionStatistics(!programEndReached());
+                  disableSteppingMode();
+                  clearTemporaryBreakPoint();
+                  if (_hotSwapReference && !programEndReached()) {
+                    applyBreakPoints();
+                  }
+                  finishHotSwap();
+                  if (!programEndReached()) {
+                    emit executionHalted();
+                  } else {
+                    cacheExecutionResult(data);
+                  }
+                  cleanUpIfEndReached();
+                })
           .onFailed([this](const VirtualMachineIsNullError& error) -> void {
             handleVirtualMachineIsNullError(error);
           })
           .onFailed([this](const ActivationsAreEmptyError& error) -> void {
             handleActivationsAreEmptyError(error);
           })
+          .onFailed([this](const MemoryLimitExceededError& error) -> void {
+            handleMemoryLimitExceededError(error);
+          })
+          .onFailed([this](const ReplayDivergedError& error) -> void {
+            handleReplayDivergedError(error);
+          })
           .onFailed([this](const std::exception& error) -> void {
             handleExecutionError(error);
           });
   watcher->setFuture(future);
+  startLiveVariablesTimer();
 }
 
 void VirtualMachineService::handleExecutionError(const std::exception& error) {
@@ -118,6 +513,27 @@ void VirtualMachineService::handleExecutionError(const std::exception& error) {
   emit executionFailedForInternalReason();
 }
 
+void VirtualMachineService::handleMemoryLimitExceededError(
+    const MemoryLimitExceededError& error) {
+  Q_UNUSED(error)
+  _peakMemoryBytes =
+      _executionCounters->peakMemoryBytes.load(std::memory_order_relaxed);
+  emit executionStatisticsChanged();
+  deinitVirtualMachine();
+  qWarning() << "Execution aborted because the memory limit of"
+             << _memoryLimitBytes << "bytes was exceeded";
+  emit memoryLimitExceeded(_memoryLimitBytes);
+}
+
+void VirtualMachineService::handleReplayDivergedError(
+    const ReplayDivergedError& error) {
+  updateExecutionStatistics();
+  deinitVirtualMachine();
+  qWarning() << "Replay diverged from the recording after"
+             << _executedInstructions << "instructions";
+  emit replayFailed(QString::fromUtf8(error.what()));
+}
+
 void VirtualMachineService::handleVirtualMachineIsNullError(
     const VirtualMachineIsNullError& error) {
   Q_UNUSED(error)
@@ -135,17 +551,74 @@ void VirtualMachineService::handleActivationsAreEmptyError(
 }
 
 QMap<QString, int> VirtualMachineService::variablesState() const {
+  QMap<QString, int> variablesState;
+  for (const auto& variable : _variablesState.asKeyValueRange()) {
+    variablesState.insert(_symbolTable.nameOf(variable.first),
+                          variable.second);
+  }
+  return variablesState;
+}
+
+VariablesState VirtualMachineService::variablesStateById() const {
   return _variablesState;
 }
 
-void VirtualMachineService::setVariablesState(VMData data) {
-  QMap<QString, int> variablesState;
-  for (auto line : data) {
-    variablesState.insert(QString::fromStdString(line.first), line.second);
+QString VirtualMachineService::symbolName(SymbolId id) const {
+  return _symbolTable.nameOf(id);
+}
+
+void VirtualMachineService::setVariablesState(const VMData& data) {
+  VariablesState variablesState;
+  for (const auto& line : data) {
+    variablesState.insert(_symbolTable.intern(line.first), line.second);
   }
   setVariablesState(variablesState);
 }
 
+int VirtualMachineService::callStackDepth() const { return _callStackDepth; }
+
+void VirtualMachineService::setCallStackDepth(int callStackDepth) {
+  if (_callStackDepth != callStackDepth) {
+    _callStackDepth = callStackDepth;
+    emit callStackDepthChanged();
+  }
+}
+
+void VirtualMachineService::updateCallStack() {
+  if (_virtualMachine.isNull()) {
+    setCallStackDepth(0);
+    return;
+  }
+  const auto& activations = _virtualMachine->getActivations();
+  setCallStackDepth(static_cast<int>(activations.size()));
+  emit callStackChanged();
+}
+
+QMap<QString, int> VirtualMachineService::frameVariablesAt(int frameIndex) {
+  if (isRunningIsolated()) {
+    const int frameCount = static_cast<int>(_isolatedFrames.size());
+    if (_isExecuting || frameIndex < 0 || frameIndex >= frameCount) {
+      return QMap<QString, int>();
+    }
+    return _isolatedFrames.at(frameCount - frameIndex - 1);
+  }
+  if (_virtualMachine.isNull() || _isExecuting) {
+    return QMap<QString, int>();
+  }
+  const auto& activations = _virtualMachine->getActivations();
+  const int activationCount = static_cast<int>(activations.size());
+  if (frameIndex < 0 || frameIndex >= activationCount) {
+    return QMap<QString, int>();
+  }
+  const auto& activation = activations.at(activationCount - frameIndex - 1);
+  QMap<QString, int> variables;
+  for (const auto& line : activation.getActivationVariables()) {
+    variables.insert(_symbolTable.nameOf(_symbolTable.intern(line.first)),
+                     line.second);
+  }
+  return variables;
+}
+
 void VirtualMachineService::cleanUpIfEndReached() {
   if (programEndReached()) {
     deinitVirtualMachine();
@@ -153,14 +626,23 @@ void VirtualMachineService::cleanUpIfEndReached() {
 }
 
 void VirtualMachineService::setVariablesState(
-    QMap<QString, int> variablesState) {
-  if (_variablesState != variablesState) {
-    _variablesState = variablesState;
-    emit variablesStateChanged();
+    const VariablesState& variablesState) {
+  const VariablesStateDelta delta(_variablesState, variablesState);
+  if (delta.isEmpty()) {
+    return;
   }
+  _variablesState = variablesState;
+  emit variablesStateUpdated(delta);
+  emit variablesStateChanged();
 }
 
-void VirtualMachineService::stopExecution() { emit stopCalled(); }
+void VirtualMachineService::stopExecution() {
+  if (isRunningIsolated()) {
+    deinitVirtualMachine();
+    return;
+  }
+  emit stopCalled();
+}
 
 void VirtualMachineService::resetVirtualMachine() {
   if (_virtualMachine.isNull()) {
@@ -170,14 +652,82 @@ void VirtualMachineService::resetVirtualMachine() {
 }
 
 bool VirtualMachineService::isRunning() const {
-  return !_virtualMachine.isNull();
+  return !_virtualMachine.isNull() || isRunningIsolated();
 }
 
-void VirtualMachineService::initVirtualMachine(const Theo::Program& program) {
-  _virtualMachine = QSharedPointer<Theo::VM>(new Theo::VM(program));
+void VirtualMachineService::initVirtualMachine(const Theo::Program& program,
+                                               const QByteArray& programHash) {
+  releaseVirtualMachine();
+  _recording.clear();
+  stopReplay();
+  _programHash = programHash;
+  _virtualMachine = takePooledVirtualMachine(programHash);
+  if (_virtualMachine.isNull()) {
+    _virtualMachine = QSharedPointer<Theo::VM>(new Theo::VM(program));
+    _appliedBreakPoints.clear();
+  } else {
+    disableSteppingMode();
+  }
+  setVariablesState(VariablesState());
+  _symbolTable.clear();
+  resetExecutionStatistics();
+  _haltSteps.clear();
   emit isRunningChanged();
 }
 
+QSharedPointer<Theo::VM> VirtualMachineService::takePooledVirtualMachine(
+    const QByteArray& programHash) {
+  if (programHash.isEmpty()) {
+    return QSharedPointer<Theo::VM>();
+  }
+  for (int index = 0; index < _virtualMachinePool.size(); ++index) {
+    const PooledVirtualMachine& entry = _virtualMachinePool.at(index);
+    if (entry.programHash != programHash) {
+      continue;
+    }
+    const PooledVirtualMachine pooled = _virtualMachinePool.takeAt(index);
+    // Theo::VM::reset() does not document whether breakpoints survive it.
+    // Setting them again makes the machine match the recorded state either
+    // way, so later updates can keep diffing against it.
+    for (const auto& file : pooled.appliedBreakPoints.asKeyValueRange()) {
+      for (const int lineNumber : file.second) {
+        pooled.virtualMachine->setBreakPoint(file.first.toStdString(),
+                                             lineNumber, true);
+      }
+    }
+    _appliedBreakPoints = pooled.appliedBreakPoints;
+    return pooled.virtualMachine;
+  }
+  return QSharedPointer<Theo::VM>();
+}
+
+void VirtualMachineService::releaseVirtualMachine() {
+  if (_virtualMachine.isNull()) {
+    return;
+  }
+  // A canceled execution may still be running on the thread pool, so only
+  // machines whose execution has finished are reset and pooled.
+  if (!_programHash.isEmpty() && _execution.isFinished() &&
+      !_execution.isCanceled()) {
+    _virtualMachine->reset();
+    for (int index = 0; index < _virtualMachinePool.size(); ++index) {
+      if (_virtualMachinePool.at(index).programHash == _programHash) {
+        _virtualMachinePool.removeAt(index);
+        break;
+      }
+    }
+    _virtualMachinePool.prepend(PooledVirtualMachine{
+        _programHash, _virtualMachine, _appliedBreakPoints});
+    while (_virtualMachinePool.size() > VIRTUAL_MACHINE_POOL_SIZE) {
+      _virtualMachinePool.removeLast();
+    }
+  }
+  _virtualMachine.clear();
+  _programHash.clear();
+  _appliedBreakPoints.clear();
+  _execution = QFuture<VMData>();
+}
+
 void VirtualMachineService::setBreakPointAt(const QString& tabName,
                                             const int lineNumber) {
   if (_breakPoints.contains(tabName)) {
@@ -185,8 +735,11 @@ void VirtualMachineService::setBreakPointAt(const QString& tabName,
   } else {
     _breakPoints.insert(tabName, {lineNumber});
   }
-  if (_isDebugging && _virtualMachine) {
-    _virtualMachine->setBreakPoint(tabName.toStdString(), lineNumber, true);
+  if (_isDebugging && _virtualMachine && _replayLog.isNull()) {
+    setAppliedBreakPoint(tabName, lineNumber, true);
+  }
+  if (_isDebugging && isRunningIsolated()) {
+    _isolatedRunner->setBreakPoint(tabName, lineNumber, true);
   }
 }
 
@@ -196,22 +749,67 @@ void VirtualMachineService::deleteBreakPointAt(const QString& tabName,
     return;
   }
   const bool removed = _breakPoints[tabName].remove(lineNumber);
-  if (removed && _isDebugging && _virtualMachine) {
-    _virtualMachine->setBreakPoint(tabName.toStdString(), lineNumber, false);
+  if (removed && _isDebugging && _virtualMachine && _replayLog.isNull()) {
+    setAppliedBreakPoint(tabName, lineNumber, false);
+  }
+  if (removed && _isDebugging && isRunningIsolated()) {
+    _isolatedRunner->setBreakPoint(tabName, lineNumber, false);
   }
 }
 
 void VirtualMachineService::applyBreakPoints() {
+  applyBreakPoints(_breakPoints);
+}
+
+void VirtualMachineService::applyBreakPoints(
+    const QMap<QString, QSet<int>>& breakPoints) {
+  if (_virtualMachine.isNull()) {
+    return;
+  }
+  const QMap<QString, QSet<int>> appliedBreakPoints = _appliedBreakPoints;
+  for (const QString& fileName : appliedBreakPoints.keys()) {
+    for (const int lineNumber : appliedBreakPoints[fileName]) {
+      if (!breakPoints.value(fileName).contains(lineNumber)) {
+        setAppliedBreakPoint(fileName, lineNumber, false);
+      }
+    }
+  }
+  for (const QString& fileName : breakPoints.keys()) {
+    for (const int lineNumber : breakPoints[fileName]) {
+      setAppliedBreakPoint(fileName, lineNumber, true);
+    }
+  }
+}
+
+void VirtualMachineService::clearAppliedBreakPoints() {
   if (_virtualMachine.isNull()) {
     return;
   }
-  for (const QString& fileName : _breakPoints.keys()) {
-    for (const int lineNumber : _breakPoints[fileName]) {
-      _virtualMachine->setBreakPoint(fileName.toStdString(), lineNumber, true);
+  const QMap<QString, QSet<int>> appliedBreakPoints = _appliedBreakPoints;
+  for (const QString& fileName : appliedBreakPoints.keys()) {
+    for (const int lineNumber : appliedBreakPoints[fileName]) {
+      setAppliedBreakPoint(fileName, lineNumber, false);
     }
   }
 }
 
+void VirtualMachineService::setAppliedBreakPoint(const QString& fileName,
+                                                 int lineNumber,
+                                                 bool enabled) {
+  if (enabled == _appliedBreakPoints.value(fileName).contains(lineNumber)) {
+    return;
+  }
+  _virtualMachine->setBreakPoint(fileName.toStdString(), lineNumber, enabled);
+  if (enabled) {
+    _appliedBreakPoints[fileName].insert(lineNumber);
+    return;
+  }
+  _appliedBreakPoints[fileName].remove(lineNumber);
+  if (_appliedBreakPoints[fileName].isEmpty()) {
+    _appliedBreakPoints.remove(fileName);
+  }
+}
+
 bool VirtualMachineService::isDebugging() const { return _isDebugging; }
 
 void VirtualMachineService::setIsDebugging(const bool isDebugging) {
@@ -225,6 +823,14 @@ void VirtualMachineService::stepNextBreakPoint() {
   if (!isRunning()) {
     return;
   }
+  if (!_replayLog.isNull()) {
+    seekReplayRecord(nextReplayHalt());
+    return;
+  }
+  if (isRunningIsolated()) {
+    resumeIsolatedRun(false);
+    return;
+  }
   startVirtualMachine();
 }
 
@@ -232,10 +838,72 @@ void VirtualMachineService::stepNextPossibleBreakPoint() {
   if (!isRunning()) {
     return;
   }
+  if (!_replayLog.isNull()) {
+    seekReplayRecord(_replayPosition + 1);
+    return;
+  }
+  if (isRunningIsolated()) {
+    resumeIsolatedRun(true);
+    return;
+  }
   enableSteppingMode();
   startVirtualMachine();
 }
 
+void VirtualMachineService::stepOver() { stepToDepth(_callStackDepth); }
+
+void VirtualMachineService::stepOut() { stepToDepth(_callStackDepth - 1); }
+
+void VirtualMachineService::stepToDepth(int maxHaltDepth) {
+  if (!isRunning() || _isExecuting || !_replayLog.isNull()) {
+    return;
+  }
+  if (isRunningIsolated()) {
+    resumeIsolatedRun(true, maxHaltDepth);
+    return;
+  }
+  _maxHaltDepth = maxHaltDepth;
+  enableSteppingMode();
+  startVirtualMachine();
+}
+
+void VirtualMachineService::runToLine(const QString& tabName,
+                                      int lineNumber) {
+  if (!isRunning() || _isExecuting || !_replayLog.isNull()) {
+    return;
+  }
+  if (!_breakPoints.value(tabName).contains(lineNumber)) {
+    _temporaryBreakPoint = QPair<QString, int>(tabName, lineNumber);
+  }
+  if (isRunningIsolated()) {
+    if (_temporaryBreakPoint) {
+      _isolatedRunner->setBreakPoint(tabName, lineNumber, true);
+    }
+    resumeIsolatedRun(false);
+    return;
+  }
+  if (_temporaryBreakPoint) {
+    setAppliedBreakPoint(tabName, lineNumber, true);
+  }
+  startVirtualMachine();
+}
+
+void VirtualMachineService::clearTemporaryBreakPoint() {
+  if (!_temporaryBreakPoint) {
+    return;
+  }
+  const auto [tabName, lineNumber] = *_temporaryBreakPoint;
+  _temporaryBreakPoint.reset();
+  if (_breakPoints.value(tabName).contains(lineNumber)) {
+    return;
+  }
+  if (isRunningIsolated()) {
+    _isolatedRunner->setBreakPoint(tabName, lineNumber, false);
+  } else if (!_virtualMachine.isNull()) {
+    setAppliedBreakPoint(tabName, lineNumber, false);
+  }
+}
+
 void VirtualMachineService::enableSteppingMode() {
   if (_virtualMachine.isNull()) {
     return;
@@ -251,3 +919,598 @@ void VirtualMachineService::disableSteppingMode() {
     _virtualMachine->setSteppingMode(false);
   }
 }
+
+bool VirtualMachineService::liveVariablesEnabled() const {
+  return _liveVariablesEnabled;
+}
+
+void VirtualMachineService::setLiveVariablesEnabled(bool enabled) {
+  if (_liveVariablesEnabled != enabled) {
+    _liveVariablesEnabled = enabled;
+    emit liveVariablesEnabledChanged();
+  }
+}
+
+int VirtualMachineService::liveVariablesMaxRateHz() const {
+  return _liveVariablesMaxRateHz;
+}
+
+void VirtualMachineService::setLiveVariablesMaxRateHz(int rateHz) {
+  if (_liveVariablesMaxRateHz != rateHz) {
+    _liveVariablesMaxRateHz = rateHz;
+    emit liveVariablesMaxRateHzChanged();
+  }
+}
+
+std::chrono::milliseconds VirtualMachineService::liveVariablesInterval() const {
+  return std::chrono::milliseconds(1000 / std::max(1, _liveVariablesMaxRateHz));
+}
+
+void VirtualMachineService::startLiveVariablesTimer() {
+  if (_liveVariables.isNull()) {
+    return;
+  }
+  _liveVariablesTimer.setInterval(liveVariablesInterval());
+  _liveVariablesTimer.start();
+}
+
+void VirtualMachineService::updateLiveVariables() {
+  if (!_isExecuting || _liveVariables.isNull()) {
+    _liveVariablesTimer.stop();
+    return;
+  }
+  if (_liveVariables->take(_liveVariablesSnapshot)) {
+    setVariablesState(_liveVariablesSnapshot);
+  }
+}
+
+int VirtualMachineService::peakCallStackDepth() const {
+  return _peakCallStackDepth;
+}
+
+qint64 VirtualMachineService::executedInstructions() const {
+  return _executedInstructions;
+}
+
+int VirtualMachineService::haltCount() const { return _haltCount; }
+
+void VirtualMachineService::resetExecutionStatistics() {
+  _executionCounters =
+      QSharedPointer<ExecutionCounters>(new ExecutionCounters());
+  _peakCallStackDepth = 0;
+  _executedInstructions = 0;
+  _peakMemoryBytes = 0;
+  _haltCount = 0;
+  emit executionStatisticsChanged();
+}
+
+void VirtualMachineService::updateExecutionStatistics(bool halted) {
+  _peakCallStackDepth = qMax(
+      _callStackDepth,
+      _executionCounters->peakCallStackDepth.load(std::memory_order_relaxed));
+  _executedInstructions =
+      _executionCounters->executedInstructions.load(std::memory_order_relaxed);
+  _peakMemoryBytes =
+      _executionCounters->peakMemoryBytes.load(std::memory_order_relaxed);
+  if (halted) {
+    ++_haltCount;
+  }
+  emit executionStatisticsChanged();
+}
+
+qint64 VirtualMachineService::peakMemoryBytes() const {
+  return _peakMemoryBytes;
+}
+
+qint64 VirtualMachineService::memoryLimitBytes() const {
+  return _memoryLimitBytes;
+}
+
+void VirtualMachineService::setMemoryLimitBytes(qint64 memoryLimitBytes) {
+  if (_memoryLimitBytes != memoryLimitBytes) {
+    _memoryLimitBytes = memoryLimitBytes;
+    emit memoryLimitBytesChanged();
+  }
+}
+
+bool VirtualMachineService::executionCacheEnabled() const {
+  return _executionCacheEnabled;
+}
+
+void VirtualMachineService::setExecutionCacheEnabled(bool enabled) {
+  if (_executionCacheEnabled != enabled) {
+    _executionCacheEnabled = enabled;
+    if (!enabled) {
+      _executionCache.clear();
+    }
+    emit executionCacheEnabledChanged();
+  }
+}
+
+bool VirtualMachineService::lastResultFromCache() const {
+  return _lastResultFromCache;
+}
+
+void VirtualMachineService::setLastResultFromCache(bool lastResultFromCache) {
+  if (_lastResultFromCache != lastResultFromCache) {
+    _lastResultFromCache = lastResultFromCache;
+    emit lastResultFromCacheChanged();
+  }
+}
+
+bool VirtualMachineService::executeFromCache(const QByteArray& programHash) {
+  if (!_executionCacheEnabled || programHash.isEmpty() ||
+      !_recordingDirectory.isEmpty()) {
+    return false;
+  }
+  const VMData* const data = _executionCache.object(programHash);
+  if (data == nullptr) {
+    return false;
+  }
+  setVariablesState(VariablesState());
+  _symbolTable.clear();
+  setVariablesState(*data);
+  resetExecutionStatistics();
+  setLastResultFromCache(true);
+  emit executionCompleted();
+  return true;
+}
+
+void VirtualMachineService::cacheExecutionResult(const VMData& data) {
+  if (!_executionCacheEnabled || _isDebugging || _programHash.isEmpty()) {
+    return;
+  }
+  _executionCache.insert(_programHash, new VMData(data),
+                         std::max<qsizetype>(1, data.size()));
+}
+
+QString VirtualMachineService::recordingDirectory() const {
+  return _recordingDirectory;
+}
+
+void VirtualMachineService::setRecordingDirectory(
+    const QString& recordingDirectory) {
+  const QUrl url(recordingDirectory);
+  const QString directory =
+      url.isLocalFile() ? url.toLocalFile() : recordingDirectory;
+  if (_recordingDirectory != directory) {
+    _recordingDirectory = directory;
+    emit recordingDirectoryChanged();
+  }
+}
+
+QString VirtualMachineService::recordingPathOf(
+    const QByteArray& programHash) const {
+  return QDir(_recordingDirectory)
+      .filePath(QString::fromLatin1(programHash.toHex().left(16)) +
+                ".theolog");
+}
+
+void VirtualMachineService::startRecording() {
+  _recording.clear();
+  if (_recordingDirectory.isEmpty() || _programHash.isEmpty() ||
+      !_replayLog.isNull()) {
+    return;
+  }
+  try {
+    QDir().mkpath(_recordingDirectory);
+    _recording = QSharedPointer<ExecutionLogWriter>(new ExecutionLogWriter(
+        recordingPathOf(_programHash), _programHash, _appliedBreakPoints));
+  } catch (const ExecutionLogOpenError& error) {
+    qWarning() << "Execution is not recorded:" << error.what();
+  }
+}
+
+bool VirtualMachineService::isReplaying() const {
+  return !_replayLog.isNull();
+}
+
+int VirtualMachineService::replayRecordCount() const {
+  if (_replayLog.isNull()) {
+    return 0;
+  }
+  return static_cast<int>(std::min<qint64>(
+      _replayLog->recordCount(), std::numeric_limits<int>::max()));
+}
+
+int VirtualMachineService::replayPosition() const { return _replayPosition; }
+
+void VirtualMachineService::setReplayPosition(int replayPosition) {
+  if (_replayPosition != replayPosition) {
+    _replayPosition = replayPosition;
+    emit replayPositionChanged();
+  }
+}
+
+void VirtualMachineService::stopReplay() {
+  if (_replayLog.isNull()) {
+    return;
+  }
+  _replayLog.clear();
+  setReplayPosition(-1);
+  emit isReplayingChanged();
+}
+
+int VirtualMachineService::nextReplayHalt() const {
+  const int recordCount = replayRecordCount();
+  for (int index = _replayPosition + 1; index < recordCount; ++index) {
+    if (_replayLog->recordAt(index).type !=
+        ExecutionLogRecordType::Checkpoint) {
+      return index;
+    }
+  }
+  return recordCount - 1;
+}
+
+void VirtualMachineService::seekReplayRecord(int recordIndex) {
+  if (_replayLog.isNull() || _isExecuting || recordIndex < 0 ||
+      recordIndex >= replayRecordCount()) {
+    return;
+  }
+  const qint64 instruction = _replayLog->recordAt(recordIndex).instruction;
+  if (instruction == _executedInstructions) {
+    setReplayPosition(recordIndex);
+    return;
+  }
+  if (instruction < _executedInstructions) {
+    resetVirtualMachine();
+    resetExecutionStatistics();
+  }
+  setReplayPosition(recordIndex);
+  _stopAtInstruction = instruction;
+  startVirtualMachine();
+}
+
+bool VirtualMachineService::isolatedExecutionEnabled() const {
+  return _isolatedExecutionEnabled;
+}
+
+void VirtualMachineService::setIsolatedExecutionEnabled(bool enabled) {
+  if (_isolatedExecutionEnabled != enabled) {
+    _isolatedExecutionEnabled = enabled;
+    emit isolatedExecutionEnabledChanged();
+  }
+}
+
+bool VirtualMachineService::isRunningIsolated() const {
+  return !_isolatedRunner.isNull() && _isolatedRunner->isActive();
+}
+
+void VirtualMachineService::executeIsolated(const CompilationTask& task) {
+  setLastResultFromCache(false);
+  startIsolatedRun(task);
+}
+
+void VirtualMachineService::debugIsolated(const CompilationTask& task) {
+  setLastResultFromCache(false);
+  setIsDebugging(true);
+  startIsolatedRun(task);
+}
+
+void VirtualMachineService::hotSwapIsolated(const CompilationTask& task) {
+  if (!isRunningIsolated() || !_isDebugging || _isExecuting) {
+    return;
+  }
+  if (_haltSteps.isEmpty()) {
+    return;
+  }
+  const QList<HaltStep> haltSteps = _haltSteps;
+  const HotSwapReference reference{variablesState(), _callStackDepth};
+  startIsolatedRun(task, haltSteps.first());
+  if (isRunningIsolated()) {
+    _hotSwapReference = reference;
+    _pendingHaltSteps = haltSteps.mid(1);
+  }
+}
+
+IsolatedRunner* VirtualMachineService::isolatedRunner() {
+  if (_isolatedRunner.isNull()) {
+    _isolatedRunner = QPointer(new IsolatedRunner(this));
+    connect(_isolatedRunner, &IsolatedRunner::liveVariablesAvailable, this,
+            &VirtualMachineService::handleIsolatedLiveVariables);
+    connect(_isolatedRunner, &IsolatedRunner::halted, this,
+            &VirtualMachineService::handleIsolatedHalted);
+    connect(_isolatedRunner, &IsolatedRunner::finished, this,
+            &VirtualMachineService::handleIsolatedFinished);
+    connect(_isolatedRunner, &IsolatedRunner::failed, this,
+            &VirtualMachineService::handleIsolatedFailed);
+  }
+  return _isolatedRunner.data();
+}
+
+void VirtualMachineService::startIsolatedRun(const CompilationTask& task) {
+  startIsolatedRun(task, HaltStep{false, std::numeric_limits<int>::max(),
+                                  _breakPoints});
+}
+
+void VirtualMachineService::startIsolatedRun(const CompilationTask& task,
+                                             const HaltStep& step) {
+  _hotSwapReference.reset();
+  _pendingHaltSteps.clear();
+  _recording.clear();
+  stopReplay();
+  releaseVirtualMachine();
+  _isolatedTask = task;
+  _isolatedFrames.clear();
+  setVariablesState(VariablesState());
+  _symbolTable.clear();
+  resetExecutionStatistics();
+  _haltSteps.clear();
+  _isExecuting = true;
+  RunnerStartOptions options;
+  options.files = task.content();
+  options.mainTabName = task.mainTabName();
+  if (_isDebugging) {
+    options.breakPoints = step.breakPoints;
+    _haltSteps.append(step);
+  }
+  options.memoryLimitBytes = _memoryLimitBytes;
+  if (_liveVariablesEnabled && !_isDebugging) {
+    options.liveVariablesIntervalMs =
+        static_cast<qint32>(liveVariablesInterval().count());
+  }
+  options.stepping = step.stepping;
+  isolatedRunner()->start(options);
+  emit isRunningChanged();
+}
+
+void VirtualMachineService::resumeIsolatedRun(bool stepping,
+                                              int maxHaltDepth) {
+  if (_isExecuting) {
+    return;
+  }
+  _isExecuting = true;
+  if (_isDebugging) {
+    _haltSteps.append(HaltStep{stepping, maxHaltDepth, activeBreakPoints()});
+  }
+  _isolatedRunner->resume(stepping, maxHaltDepth);
+}
+
+QMap<QString, QSet<int>> VirtualMachineService::activeBreakPoints() const {
+  QMap<QString, QSet<int>> breakPoints = _breakPoints;
+  if (_temporaryBreakPoint) {
+    breakPoints[_temporaryBreakPoint->first].insert(
+        _temporaryBreakPoint->second);
+  }
+  return breakPoints;
+}
+
+void VirtualMachineService::setIsolatedBreakPoints(
+    const QMap<QString, QSet<int>>& current,
+    const QMap<QString, QSet<int>>& target) {
+  for (const QString& fileName : current.keys()) {
+    for (const int lineNumber : current[fileName]) {
+      if (!target.value(fileName).contains(lineNumber)) {
+        _isolatedRunner->setBreakPoint(fileName, lineNumber, false);
+      }
+    }
+  }
+  for (const QString& fileName : target.keys()) {
+    for (const int lineNumber : target[fileName]) {
+      if (!current.value(fileName).contains(lineNumber)) {
+        _isolatedRunner->setBreakPoint(fileName, lineNumber, true);
+      }
+    }
+  }
+}
+
+void VirtualMachineService::setIsolatedState(const RunnerState& state) {
+  _isolatedFrames = state.frames;
+  VariablesState variablesState;
+  if (!state.frames.isEmpty()) {
+    for (const auto& variable : state.frames.last().asKeyValueRange()) {
+      variablesState.insert(_symbolTable.intern(variable.first.toStdString()),
+                            variable.second);
+    }
+  }
+  setVariablesState(variablesState);
+  _executionCounters->executedInstructions.store(state.executedInstructions,
+                                                 std::memory_order_relaxed);
+  _executionCounters->peakCallStackDepth.store(state.peakCallStackDepth,
+                                               std::memory_order_relaxed);
+  _executionCounters->peakMemoryBytes.store(state.peakMemoryBytes,
+                                            std::memory_order_relaxed);
+}
+
+void VirtualMachineService::handleIsolatedLiveVariables(
+    const RunnerState& state) {
+  if (_isExecuting) {
+    setIsolatedState(state);
+  }
+}
+
+void VirtualMachineService::handleIsolatedHalted(const RunnerState& state) {
+  _isExecuting = false;
+  if (!_pendingHaltSteps.isEmpty()) {
+    retraceHaltStep();
+    return;
+  }
+  setIsolatedState(state);
+  setCallStackDepth(static_cast<int>(state.frames.size()));
+  emit callStackChanged();
+  updateExecutionStatistics(true);
+  clearTemporaryBreakPoint();
+  if (_hotSwapReference) {
+    setIsolatedBreakPoints(_haltSteps.last().breakPoints, _breakPoints);
+  }
+  finishHotSwap();
+  emit executionHalted();
+}
+
+void VirtualMachineService::handleIsolatedFinished(const RunnerState& state) {
+  _isExecuting = false;
+  setIsolatedState(state);
+  setCallStackDepth(static_cast<int>(state.frames.size()));
+  updateExecutionStatistics();
+  finishHotSwap();
+  deinitVirtualMachine();
+}
+
+void VirtualMachineService::handleIsolatedFailed(RunnerFailure failure) {
+  if (failure == RunnerFailure::MemoryLimitExceeded) {
+    handleMemoryLimitExceededError(MemoryLimitExceededError());
+    return;
+  }
+  deinitVirtualMachine();
+  qCritical() << "Execution in the runner process failed";
+  emit executionFailedForInternalReason();
+}
+
+bool VirtualMachineService::isSweeping() const {
+  return !_sweepWatcher.isNull();
+}
+
+int VirtualMachineService::sweepTimeoutMs() const { return _sweepTimeoutMs; }
+
+void VirtualMachineService::setSweepTimeoutMs(int sweepTimeoutMs) {
+  if (_sweepTimeoutMs != sweepTimeoutMs) {
+    _sweepTimeoutMs = sweepTimeoutMs;
+    emit sweepTimeoutMsChanged();
+  }
+}
+
+void VirtualMachineService::sweep(const CompilationTask& task,
+                                  const QList<VariableOverrides>& variants) {
+  stopSweep();
+  _sweepCanceled = QSharedPointer<std::atomic<bool>>(new std::atomic<bool>());
+  // Every variant overrides the same source, so it is scanned only once.
+  const SweepOptions options{
+      std::chrono::milliseconds(_sweepTimeoutMs), _memoryLimitBytes,
+      _sweepCanceled,
+      findTopLevelAssignments(task.content().value(task.mainTabName()))};
+  QList<int> variantIndices;
+  for (const int variantIndex : std::views::iota(0, variants.size())) {
+    variantIndices.append(variantIndex);
+  }
+  auto watcher = new QFutureWatcher<SweepResult>(this);
+  connect(watcher, &QFutureWatcher<SweepResult>::resultReadyAt, this,
+          [this, watcher](int index) -> void {
+            if (_sweepWatcher == watcher) {
+              emit sweepResultReady(watcher->resultAt(index));
+            }
+          });
+  connect(watcher, &QFutureWatcher<SweepResult>::finished, this,
+          [this, watcher]() -> void {
+            watcher->deleteLater();
+            if (_sweepWatcher == watcher) {
+              _sweepWatcher.clear();
+              emit isSweepingChanged();
+              emit sweepFinished();
+            }
+          });
+  _sweepWatcher = watcher;
+  emit isSweepingChanged();
+  emit sweepStarted(static_cast<int>(variants.size()));
+  watcher->setFuture(QtConcurrent::mapped(
+      &_sweepThreadPool, variantIndices,
+      [task, variants, options](int variantIndex) -> SweepResult {
+        return executeSweepVariant(task, variantIndex,
+                                   variants.at(variantIndex), options);
+      }));
+}
+
+void VirtualMachineService::stopSweep() {
+  if (_sweepWatcher.isNull()) {
+    return;
+  }
+  _sweepCanceled->store(true);
+  _sweepWatcher->cancel();
+  _sweepWatcher.clear();
+  emit isSweepingChanged();
+  emit sweepFinished();
+}
+
+SweepResult VirtualMachineService::executeSweepVariant(
+    const CompilationTask& task, int variantIndex,
+    const VariableOverrides& overrides, const SweepOptions& options) {
+  SweepResult result;
+  result.variantIndex = variantIndex;
+  result.overrides = overrides;
+  std::map<Theo::FileName, Theo::FileContent> files;
+  const QMap<QString, QString> content =
+      applyOverrides(task, overrides, options.assignments);
+  for (const auto& file : content.asKeyValueRange()) {
+    files.emplace(file.first.toStdString(), file.second.toStdString());
+  }
+  const Theo::CodegenResult codegenResult =
+      Theo::compile(files, task.mainTabName().toStdString());
+  if (!codegenResult.generated_correctly) {
+    result.error = codegenResult.errors.empty()
+                       ? tr("Compilation failed")
+                       : QString::fromStdString(
+                             codegenResult.errors.front().message);
+    return result;
+  }
+  auto vm = QSharedPointer<Theo::VM>(new Theo::VM(codegenResult.code));
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point deadline = Clock::now() + options.timeout;
+  int instructionsUntilCheck = 0;
+  int instructionsUntilMemoryCheck = MemoryEstimate::CHECK_INSTRUCTIONS;
+  MemoryEstimate memoryEstimate;
+  while (!vm->isDone()) {
+    vm->executeSingle();
+    memoryEstimate.track(*vm);
+    --instructionsUntilMemoryCheck;
+    if (--instructionsUntilCheck > 0) {
+      continue;
+    }
+    instructionsUntilCheck = SWEEP_CHECK_INSTRUCTIONS;
+    if (options.canceled->load(std::memory_order_relaxed)) {
+      result.error = tr("Canceled");
+      return result;
+    }
+    if (Clock::now() >= deadline) {
+      result.error = tr("Timeout");
+      return result;
+    }
+    if (instructionsUntilMemoryCheck <= 0) {
+      instructionsUntilMemoryCheck = MemoryEstimate::CHECK_INSTRUCTIONS;
+      if (options.memoryLimitBytes > 0 &&
+          memoryEstimate.bytes(*vm) > options.memoryLimitBytes) {
+        result.error = tr("Memory limit exceeded");
+        return result;
+      }
+    }
+  }
+  const auto& activations = vm->getActivations();
+  if (activations.empty()) {
+    result.error = tr("No activations");
+    return result;
+  }
+  result.variables =
+      convertVariables(activations.back().getActivationVariables());
+  result.succeeded = true;
+  return result;
+}
+
+QMap<QString, QString> VirtualMachineService::applyOverrides(
+    const CompilationTask& task, const VariableOverrides& overrides,
+    const TopLevelAssignments& assignments) {
+  QMap<QString, QString> content = task.content();
+  if (overrides.isEmpty()) {
+    return content;
+  }
+  QString& mainContent = content[task.mainTabName()];
+  QMap<qsizetype, QPair<qsizetype, QString>> replacements;
+  QString prologue;
+  for (const auto& variable : overrides.asKeyValueRange()) {
+    const QString statement =
+        QString("%1 := %2;").arg(variable.first).arg(variable.second);
+    const auto assignment = assignments.constFind(variable.first);
+    if (assignment != assignments.constEnd()) {
+      replacements.insert(assignment->first,
+                          qMakePair(assignment->second, statement));
+    } else {
+      prologue.append(statement + ' ');
+    }
+  }
+  // Replacing from the back keeps the positions of the earlier ones valid.
+  for (auto replacement = replacements.cend();
+       replacement != replacements.cbegin();) {
+    --replacement;
+    mainContent.replace(replacement.key(), replacement->first,
+                        replacement->second);
+  }
+  mainContent.prepend(prologue);
+  return content;
+}
@@ -0,0 +1,235 @@
+#include <QVarLengthArray>
+
+#include "watchexpression.hpp"
+
+// The VM computes with 32-bit ints that wrap around, so the watch values do
+// the arithmetic on unsigned integers and convert the result back.
+static int wrap(quint32 value) { return static_cast<int>(value); }
+
+class WatchExpression::Parser {
+ public:
+  Parser(const QString& source, WatchExpression& expression)
+      : _source(source), _expression(expression) {}
+
+  void parse() {
+    parseComparison();
+    skipWhitespace();
+    if (_position != _source.size()) {
+      throw WatchExpressionSyntaxError();
+    }
+  }
+
+ private:
+  const QString& _source;
+  WatchExpression& _expression;
+  qsizetype _position = 0;
+
+  void append(OpCode opCode, qint64 operand = 0) {
+    _expression._code.append(Instruction{opCode, operand});
+  }
+
+  void skipWhitespace() {
+    while (_position < _source.size() && _source.at(_position).isSpace()) {
+      ++_position;
+    }
+  }
+
+  bool accept(const QString& token) {
+    skipWhitespace();
+    if (_source.sliced(_position).startsWith(token)) {
+      _position += token.size();
+      return true;
+    }
+    return false;
+  }
+
+  void parseComparison() {
+    parseAdditive();
+    const QList<QPair<QString, OpCode>> operators = {
+        {"<=", OpCode::LessEqual}, {">=", OpCode::GreaterEqual},
+        {"==", OpCode::Equal},     {"!=", OpCode::NotEqual},
+        {"<", OpCode::Less},       {">", OpCode::Greater},
+        {"=", OpCode::Equal},
+    };
+    for (const auto& [token, opCode] : operators) {
+      if (accept(token)) {
+        parseAdditive();
+        append(opCode);
+        return;
+      }
+    }
+  }
+
+  void parseAdditive() {
+    parseTerm();
+    while (true) {
+      if (accept("+")) {
+        parseTerm();
+        append(OpCode::Add);
+      } else if (accept("-")) {
+        parseTerm();
+        append(OpCode::Subtract);
+      } else {
+        return;
+      }
+    }
+  }
+
+  void parseTerm() {
+    parseUnary();
+    while (true) {
+      if (accept("*")) {
+        parseUnary();
+        append(OpCode::Multiply);
+      } else if (accept("/")) {
+        parseUnary();
+        append(OpCode::Divide);
+      } else if (accept("%")) {
+        parseUnary();
+        append(OpCode::Modulo);
+      } else {
+        return;
+      }
+    }
+  }
+
+  void parseUnary() {
+    if (accept("-")) {
+      parseUnary();
+      append(OpCode::Negate);
+      return;
+    }
+    parsePrimary();
+  }
+
+  void parsePrimary() {
+    if (accept("(")) {
+      parseComparison();
+      if (!accept(")")) {
+        throw WatchExpressionSyntaxError();
+      }
+      return;
+    }
+    skipWhitespace();
+    const qsizetype start = _position;
+    if (_position < _source.size() && _source.at(_position).isDigit()) {
+      while (_position < _source.size() && _source.at(_position).isDigit()) {
+        ++_position;
+      }
+      bool ok = false;
+      const int value =
+          _source.sliced(start, _position - start).toInt(&ok);
+      if (!ok) {
+        throw WatchExpressionSyntaxError();
+      }
+      append(OpCode::PushConstant, value);
+      return;
+    }
+    while (_position < _source.size() &&
+           (_source.at(_position).isLetterOrNumber() ||
+            _source.at(_position) == '_')) {
+      ++_position;
+    }
+    if (_position == start || _source.at(start).isDigit()) {
+      throw WatchExpressionSyntaxError();
+    }
+    const QString name = _source.sliced(start, _position - start);
+    qsizetype variableIndex = _expression._variableNames.indexOf(name);
+    if (variableIndex < 0) {
+      variableIndex = _expression._variableNames.size();
+      _expression._variableNames.append(name);
+      _expression._referencedVariables.insert(name);
+    }
+    append(OpCode::PushVariable, variableIndex);
+  }
+};
+
+WatchExpression WatchExpression::compile(const QString& source) {
+  WatchExpression expression;
+  expression._source = source.trimmed();
+  Parser(expression._source, expression).parse();
+  return expression;
+}
+
+QString WatchExpression::source() const { return _source; }
+
+const QSet<QString>& WatchExpression::referencedVariables() const {
+  return _referencedVariables;
+}
+
+WatchValue WatchExpression::evaluate(
+    const QMap<QString, int>& variables) const {
+  QVarLengthArray<int, 16> values;
+  for (const QString& name : _variableNames) {
+    const auto variable = variables.constFind(name);
+    if (variable == variables.constEnd()) {
+      return WatchValue{std::nullopt, tr("%1 is undefined").arg(name)};
+    }
+    values.append(variable.value());
+  }
+  QVarLengthArray<int, 16> stack;
+  for (const Instruction& instruction : _code) {
+    switch (instruction.opCode) {
+      case OpCode::PushConstant:
+        stack.append(static_cast<int>(instruction.operand));
+        continue;
+      case OpCode::PushVariable:
+        stack.append(values.at(instruction.operand));
+        continue;
+      case OpCode::Negate:
+        stack.last() = wrap(0u - static_cast<quint32>(stack.last()));
+        continue;
+      default:
+        break;
+    }
+    const int right = stack.takeLast();
+    int& left = stack.last();
+    switch (instruction.opCode) {
+      case OpCode::Add:
+        left = wrap(static_cast<quint32>(left) + static_cast<quint32>(right));
+        break;
+      case OpCode::Subtract:
+        left = wrap(static_cast<quint32>(left) - static_cast<quint32>(right));
+        break;
+      case OpCode::Multiply:
+        left = wrap(static_cast<quint32>(left) * static_cast<quint32>(right));
+        break;
+      case OpCode::Divide:
+      case OpCode::Modulo:
+        if (right == 0) {
+          return WatchValue{std::nullopt, tr("Division by zero")};
+        }
+        if (right == -1) {
+          // INT_MIN / -1 overflows, so divide by -1 as a wrapping negation.
+          left = instruction.opCode == OpCode::Divide
+                     ? wrap(0u - static_cast<quint32>(left))
+                     : 0;
+          break;
+        }
+        left = instruction.opCode == OpCode::Divide ? left / right
+                                                    : left % right;
+        break;
+      case OpCode::Less:
+        left = left < right;
+        break;
+      case OpCode::LessEqual:
+        left = left <= right;
+        break;
+      case OpCode::Greater:
+        left = left > right;
+        break;
+      case OpCode::GreaterEqual:
+        left = left >= right;
+        break;
+      case OpCode::Equal:
+        left = left == right;
+        break;
+      case OpCode::NotEqual:
+        left = left != right;
+        break;
+      default:
+        break;
+    }
+  }
+  return WatchValue{stack.last(), QString()};
+}
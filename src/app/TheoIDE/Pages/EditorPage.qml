@@ -21,7 +21,7 @@ Page {
                     action: stopExecutionAction
                 }
                 primaryActionButton {
-                    action: runScriptAction
+                    action: applyChangesAction
                 }
             }
         },
@@ -41,6 +41,9 @@ Page {
                 debugScriptAction {
                     enabled: false
                 }
+                replayRecordingAction {
+                    enabled: false
+                }
                 createFileAction {
                     enabled: false
                 }
@@ -86,6 +89,21 @@ Page {
         onTriggered: root.model.runScriptInDebugMode()
     }
 
+    Action {
+        id: applyChangesAction
+        icon.name: "published_with_changes"
+        text: qsTr("Apply Changes")
+        enabled: root.model.executionState === ExecutionState.Halt
+        onTriggered: root.model.applyChanges()
+    }
+
+    Action {
+        id: replayRecordingAction
+        icon.name: "replay"
+        text: qsTr("Replay Recording")
+        onTriggered: replayOpenDialog.open()
+    }
+
     Action {
         id: openMoreActionsMenuAction
         icon.name: "more_vert"
@@ -147,6 +165,15 @@ Page {
                 ToolTip.delay: parent.toolTipDelay
                 icon.color: ApplicationSettings.foreground
             }
+            ToolButton {
+                action: replayRecordingAction
+                display: AbstractButton.IconOnly
+                visible: !headerToolBar.showMoreActionMenu
+                ToolTip.visible: hovered
+                ToolTip.text: text
+                ToolTip.delay: parent.toolTipDelay
+                icon.color: ApplicationSettings.foreground
+            }
 
             Label {
                 Layout.fillWidth: true
@@ -165,7 +192,7 @@ Page {
                 action: runScriptAction
                 display: AbstractButton.IconOnly
                 ToolTip.visible: hovered
-                ToolTip.text: text
+                ToolTip.text: action === applyChangesAction ? qsTr("Apply Changes by running the script again from the start up to this halt. Long runs take as long again.") : text
                 ToolTip.delay: parent.toolTipDelay
                 icon.color: ApplicationSettings.foreground
             }
@@ -214,6 +241,9 @@ Page {
         MenuItem {
             action: saveAllFilesAction
         }
+        MenuItem {
+            action: replayRecordingAction
+        }
         MenuItem {
             action: openSettingsAction
         }
@@ -257,4 +287,16 @@ Page {
             });
         }
     }
+
+    FileDialog {
+        id: replayOpenDialog
+        nameFilters: ["Theo IDE Execution Logs (*.theolog)", "All Files (*)"]
+        acceptLabel: qsTr("Replay")
+        rejectLabel: qsTr("Cancel")
+        Component.onCompleted: {
+            currentFolder = StandardPaths.writableLocation(StandardPaths.AppDataLocation) + "/recordings";
+        }
+        fileMode: FileDialog.OpenFile
+        onAccepted: root.model.replayRecording(selectedFile)
+    }
 }
@@ -65,18 +65,34 @@ Item {
         category: "General"
         property int maxReadFileSizeBytes: 2 * 1024 * 1024
         property int blockSizeBytes: 1024
+        property int largeFileThresholdBytes: 1024 * 1024
         property int tabStopDistanceInSpaces: 3
         property bool expandTabsToSpaces: false
         property int compilationTimeoutMs: 5000
         property int executionTimeoutMs: 5000
+        property int hibernationTimeoutMs: 30 * 60 * 1000
+        property bool liveVariablesEnabled: false
+        property int liveVariablesMaxRateHz: 10
+        property bool executionCacheEnabled: false
+        property bool executionRecordingEnabled: false
+        property bool isolatedExecutionEnabled: false
+        property int executionMemoryLimitBytes: 256 * 1024 * 1024
     }
 
     property alias maxReadFileSizeBytes: generalSettings.maxReadFileSizeBytes
     property alias blockSizeBytes: generalSettings.blockSizeBytes
+    property alias largeFileThresholdBytes: generalSettings.largeFileThresholdBytes
     property alias tabStopDistanceInSpaces: generalSettings.tabStopDistanceInSpaces
     property alias expandTabsToSpaces: generalSettings.expandTabsToSpaces
     property alias compilationTimeoutMs: generalSettings.compilationTimeoutMs
     property alias executionTimeoutMs: generalSettings.executionTimeoutMs
+    property alias hibernationTimeoutMs: generalSettings.hibernationTimeoutMs
+    property alias liveVariablesEnabled: generalSettings.liveVariablesEnabled
+    property alias liveVariablesMaxRateHz: generalSettings.liveVariablesMaxRateHz
+    property alias executionCacheEnabled: generalSettings.executionCacheEnabled
+    property alias executionRecordingEnabled: generalSettings.executionRecordingEnabled
+    property alias isolatedExecutionEnabled: generalSettings.isolatedExecutionEnabled
+    property alias executionMemoryLimitBytes: generalSettings.executionMemoryLimitBytes
 
     readonly property int tabStopDistance: SystemFontConfiguraton.calculateSpaceWidthOfFont(editorFont) * tabStopDistanceInSpaces
 
@@ -0,0 +1,53 @@
+#ifndef _THEOIDE_RUNNER_RUNNER_
+#define _THEOIDE_RUNNER_RUNNER_
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QLocalSocket>
+#include <QObject>
+#include <QSharedPointer>
+#include <QString>
+#include <limits>
+
+#include "VM/include/vm.hpp"
+#include "memoryestimate.hpp"
+#include "runnerprotocol.hpp"
+#include "sharedmemoryring.hpp"
+
+class Runner : public QObject {
+  Q_OBJECT
+ public:
+  Runner(const QString& name, QObject* parent = nullptr);
+  ~Runner();
+  bool connectToIde();
+
+ protected slots:
+  void handleReadyRead();
+  void continueExecution();
+
+ private:
+  QString _name;
+  QLocalSocket _socket;
+  QDataStream _stream;
+  SharedMemoryRing _ring;
+  QSharedPointer<Theo::VM> _virtualMachine;
+  RunnerStartOptions _options;
+  int _maxHaltDepth = std::numeric_limits<int>::max();
+  bool _isExecuting = false;
+  qint64 _executedInstructions = 0;
+  qint32 _peakCallStackDepth = 0;
+  qint64 _peakMemoryBytes = 0;
+  MemoryEstimate _memoryEstimate;
+
+  void start(const RunnerStartOptions& options);
+  void resume(bool stepping, int maxHaltDepth);
+  void setBreakPoint(const QString& fileName, int lineNumber, bool enabled);
+  void scheduleExecution();
+  RunnerState state() const;
+  void publish(RunnerEvent event, const RunnerState& state);
+  void publishFailure(RunnerFailure failure);
+  void publishPayload(const QByteArray& payload);
+  void send(const QByteArray& message);
+};
+
+#endif
@@ -0,0 +1,22 @@
+#include <QCoreApplication>
+#include <QtLogging>
+
+#include "runner.hpp"
+
+int main(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  app.setApplicationName("TheoIDERunner");
+  app.setOrganizationName("theoide");
+  app.setOrganizationDomain("Theo-IDE.github.io");
+
+  const QStringList arguments = app.arguments();
+  if (arguments.size() != 2) {
+    qCritical() << "Usage: TheoIDERunner <channel name>";
+    return 1;
+  }
+  Runner runner(arguments.at(1));
+  if (!runner.connectToIde()) {
+    return 1;
+  }
+  return app.exec();
+}
@@ -0,0 +1,232 @@
+#include <QCoreApplication>
+#include <QtLogging>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <map>
+
+#include "compiler.hpp"
+#include "runner.hpp"
+
+Runner::Runner(const QString& name, QObject* parent)
+    : QObject(parent), _name(name) {
+  _stream.setDevice(&_socket);
+  connect(&_socket, &QLocalSocket::readyRead, this, &Runner::handleReadyRead);
+  connect(&_socket, &QLocalSocket::disconnected, QCoreApplication::instance(),
+          &QCoreApplication::quit);
+}
+
+Runner::~Runner() {}
+
+bool Runner::connectToIde() {
+  _socket.connectToServer(_name);
+  if (!_socket.waitForConnected()) {
+    qCritical() << "Failed to connect to the IDE" << _socket.errorString();
+    return false;
+  }
+  if (!_ring.attach(_name)) {
+    qCritical() << "Failed to attach to the shared memory of the IDE";
+    return false;
+  }
+  return true;
+}
+
+void Runner::handleReadyRead() {
+  while (true) {
+    _stream.startTransaction();
+    QByteArray message;
+    _stream >> message;
+    if (!_stream.commitTransaction()) {
+      return;
+    }
+    QDataStream messageStream(message);
+    RunnerCommand command;
+    messageStream >> command;
+    switch (command) {
+      case RunnerCommand::Start: {
+        RunnerStartOptions options;
+        messageStream >> options;
+        start(options);
+        break;
+      }
+      case RunnerCommand::Resume: {
+        bool stepping = false;
+        qint32 maxHaltDepth = 0;
+        messageStream >> stepping >> maxHaltDepth;
+        resume(stepping, maxHaltDepth);
+        break;
+      }
+      case RunnerCommand::SetBreakPoint: {
+        QString fileName;
+        qint32 lineNumber = 0;
+        bool enabled = false;
+        messageStream >> fileName >> lineNumber >> enabled;
+        setBreakPoint(fileName, lineNumber, enabled);
+        break;
+      }
+    }
+  }
+}
+
+void Runner::start(const RunnerStartOptions& options) {
+  if (!_virtualMachine.isNull()) {
+    return;
+  }
+  _options = options;
+  std::map<Theo::FileName, Theo::FileContent> files;
+  for (const auto& file : options.files.asKeyValueRange()) {
+    files.emplace(file.first.toStdString(), file.second.toStdString());
+  }
+  const Theo::CodegenResult result =
+      Theo::compile(files, options.mainTabName.toStdString());
+  if (!result.generated_correctly) {
+    publishFailure(RunnerFailure::CompilationFailed);
+    return;
+  }
+  _virtualMachine = QSharedPointer<Theo::VM>(new Theo::VM(result.code));
+  for (const auto& file : options.breakPoints.asKeyValueRange()) {
+    for (const int lineNumber : file.second) {
+      _virtualMachine->setBreakPoint(file.first.toStdString(), lineNumber,
+                                     true);
+    }
+  }
+  _virtualMachine->setSteppingMode(options.stepping);
+  scheduleExecution();
+}
+
+void Runner::resume(bool stepping, int maxHaltDepth) {
+  if (_virtualMachine.isNull() || _isExecuting || _virtualMachine->isDone()) {
+    return;
+  }
+  _virtualMachine->setSteppingMode(stepping);
+  _maxHaltDepth = maxHaltDepth;
+  scheduleExecution();
+}
+
+void Runner::setBreakPoint(const QString& fileName, int lineNumber,
+                           bool enabled) {
+  if (_virtualMachine.isNull()) {
+    return;
+  }
+  _virtualMachine->setBreakPoint(fileName.toStdString(), lineNumber, enabled);
+}
+
+void Runner::scheduleExecution() {
+  _isExecuting = true;
+  QMetaObject::invokeMethod(this, &Runner::continueExecution,
+                            Qt::QueuedConnection);
+}
+
+void Runner::continueExecution() {
+  using Clock = std::chrono::steady_clock;
+  const std::chrono::milliseconds liveVariablesInterval(
+      _options.liveVariablesIntervalMs);
+  Clock::time_point nextLiveVariablesUpdate =
+      Clock::now() + liveVariablesInterval;
+  int instructionsUntilCheck = MemoryEstimate::CHECK_INSTRUCTIONS;
+  const bool stepsToDepth = _maxHaltDepth != std::numeric_limits<int>::max();
+  try {
+    while (true) {
+      const bool stepped =
+          stepsToDepth && _virtualMachine->isSteppingModeEnabled();
+      const bool stopped = _virtualMachine->executeSingle();
+      ++_executedInstructions;
+      const qint32 callStackDepth =
+          static_cast<qint32>(_virtualMachine->getActivations().size());
+      _peakCallStackDepth = std::max(_peakCallStackDepth, callStackDepth);
+      if (stepsToDepth) {
+        const bool stepsHere = callStackDepth <= _maxHaltDepth;
+        if (_virtualMachine->isSteppingModeEnabled() != stepsHere) {
+          _virtualMachine->setSteppingMode(stepsHere);
+        }
+      }
+      _memoryEstimate.track(*_virtualMachine);
+      if (--instructionsUntilCheck > 0 && !stopped) {
+        continue;
+      }
+      instructionsUntilCheck = MemoryEstimate::CHECK_INSTRUCTIONS;
+      _peakMemoryBytes =
+          std::max(_peakMemoryBytes, _memoryEstimate.bytes(*_virtualMachine));
+      if (_options.memoryLimitBytes > 0 &&
+          _peakMemoryBytes > _options.memoryLimitBytes) {
+        _isExecuting = false;
+        publishFailure(RunnerFailure::MemoryLimitExceeded);
+        return;
+      }
+      if (stopped && stepped && callStackDepth > _maxHaltDepth &&
+          !_virtualMachine->isDone()) {
+        continue;
+      }
+      if (stopped) {
+        break;
+      }
+      if (liveVariablesInterval.count() > 0 &&
+          Clock::now() >= nextLiveVariablesUpdate) {
+        nextLiveVariablesUpdate = Clock::now() + liveVariablesInterval;
+        publish(RunnerEvent::LiveVariables, state());
+      }
+      QCoreApplication::processEvents();
+    }
+  } catch (const std::exception& error) {
+    qCritical() << "Execution failed because of an exception" << error.what();
+    _isExecuting = false;
+    publishFailure(RunnerFailure::Internal);
+    return;
+  }
+  _isExecuting = false;
+  _maxHaltDepth = std::numeric_limits<int>::max();
+  if (_virtualMachine->isSteppingModeEnabled()) {
+    _virtualMachine->setSteppingMode(false);
+  }
+  publish(_virtualMachine->isDone() ? RunnerEvent::Finished
+                                    : RunnerEvent::Halted,
+          state());
+}
+
+RunnerState Runner::state() const {
+  RunnerState state;
+  for (const auto& activation : _virtualMachine->getActivations()) {
+    QMap<QString, int> variables;
+    for (const auto& variable : activation.getActivationVariables()) {
+      variables.insert(QString::fromStdString(variable.first),
+                       variable.second);
+    }
+    state.frames.append(variables);
+  }
+  state.executedInstructions = _executedInstructions;
+  state.peakCallStackDepth = _peakCallStackDepth;
+  state.peakMemoryBytes = _peakMemoryBytes;
+  return state;
+}
+
+void Runner::publish(RunnerEvent event, const RunnerState& state) {
+  QByteArray payload;
+  QDataStream stream(&payload, QIODevice::WriteOnly);
+  stream << event << state;
+  publishPayload(payload);
+}
+
+void Runner::publishFailure(RunnerFailure failure) {
+  QByteArray payload;
+  QDataStream stream(&payload, QIODevice::WriteOnly);
+  stream << RunnerEvent::Failed << failure;
+  publishPayload(payload);
+}
+
+void Runner::publishPayload(const QByteArray& payload) {
+  QByteArray message;
+  QDataStream stream(&message, QIODevice::WriteOnly);
+  quint64 sequence = 0;
+  if (_ring.write(payload, sequence)) {
+    stream << RunnerMessage::EventsWritten << sequence;
+  } else {
+    stream << RunnerMessage::Event << payload;
+  }
+  send(message);
+}
+
+void Runner::send(const QByteArray& message) {
+  _stream << message;
+  _socket.flush();
+}
@@ -1,3 +1,4 @@
+import QtCore
 import TheoIDE.Pages
 import QtQuick.Controls.Material
 import TheoIDE.Persistence
@@ -34,9 +35,18 @@ ApplicationWindow {
     property FileSystemService fileSystemService: FileSystemService {
         maxFileSizeBytes: ApplicationSettings.maxReadFileSizeBytes
         blockSizeBytes: ApplicationSettings.blockSizeBytes
+        largeFileThresholdBytes: ApplicationSettings.largeFileThresholdBytes
     }
     property CompilerService compilerService: CompilerService {}
-    property VirtualMachineService virtualMachineService: VirtualMachineService {}
+    property VirtualMachineService virtualMachineService: VirtualMachineService {
+        liveVariablesEnabled: ApplicationSettings.liveVariablesEnabled
+        liveVariablesMaxRateHz: ApplicationSettings.liveVariablesMaxRateHz
+        executionCacheEnabled: ApplicationSettings.executionCacheEnabled
+        memoryLimitBytes: ApplicationSettings.executionMemoryLimitBytes
+        sweepTimeoutMs: ApplicationSettings.executionTimeoutMs
+        isolatedExecutionEnabled: ApplicationSettings.isolatedExecutionEnabled
+        recordingDirectory: ApplicationSettings.executionRecordingEnabled ? StandardPaths.writableLocation(StandardPaths.AppDataLocation) + "/recordings" : ""
+    }
 
     ApplicationMessageDialog {
         model: MessageDialogModel {
@@ -57,6 +67,7 @@ ApplicationWindow {
                 virtualMachineService: root.virtualMachineService
                 compilationTimeoutMs: ApplicationSettings.compilationTimeoutMs
                 executionTimeoutMs: ApplicationSettings.executionTimeoutMs
+                hibernationTimeoutMs: ApplicationSettings.hibernationTimeoutMs
             }
         }
     }
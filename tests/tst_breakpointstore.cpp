@@ -0,0 +1,180 @@
+#include <QList>
+#include <QSignalSpy>
+#include <QTest>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include "breakpointstore.hpp"
+
+class TestBreakPointStore : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void setBreakPointChecksLineNumber();
+  void deletingWholeLinesMovesFollowingLine();
+  void deletingIntoLineDropsItsBreakPoint();
+  void joiningLinesDropsJoinedBreakPoint();
+  void deletingEmptyLineMovesNextLine();
+  void insertingLinesAtLineStartMovesLine();
+  void insertingLinesInsideLineKeepsLine();
+  void editsWithinLineKeepBreakPoints();
+  void changedLinesAreSignalled();
+
+ private:
+  static QString numberedLines(int lineCount);
+  static void select(QTextCursor& cursor, int fromLine, int fromColumn,
+                     int toLine, int toColumn);
+};
+
+QString TestBreakPointStore::numberedLines(int lineCount) {
+  QStringList lines;
+  for (int line = 1; line <= lineCount; ++line) {
+    lines.append(QString("line%1 := %1;").arg(line));
+  }
+  return lines.join('\n');
+}
+
+void TestBreakPointStore::select(QTextCursor& cursor, int fromLine,
+                                 int fromColumn, int toLine, int toColumn) {
+  QTextDocument* const document = cursor.document();
+  cursor.setPosition(document->findBlockByNumber(fromLine - 1).position() +
+                     fromColumn);
+  cursor.setPosition(
+      document->findBlockByNumber(toLine - 1).position() + toColumn,
+      QTextCursor::KeepAnchor);
+}
+
+void TestBreakPointStore::setBreakPointChecksLineNumber() {
+  QTextDocument document(numberedLines(3));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  QCOMPARE(BreakPointStore::of(&document), store);
+  QVERIFY(!store->setBreakPoint(0, true));
+  QVERIFY(!store->setBreakPoint(4, true));
+  QVERIFY(store->setBreakPoint(3, true));
+  QVERIFY(store->setBreakPoint(1, true));
+  QCOMPARE(store->lineNumbers(), (QList<int>{1, 3}));
+  QVERIFY(store->setBreakPoint(1, false));
+  QCOMPARE(store->lineNumbers(), QList<int>{3});
+}
+
+void TestBreakPointStore::deletingWholeLinesMovesFollowingLine() {
+  QTextDocument document(numberedLines(8));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  for (const int lineNumber : {2, 3, 4, 5, 7}) {
+    store->setBreakPoint(lineNumber, true);
+  }
+  QTextCursor cursor(&document);
+  select(cursor, 3, 0, 5, 0);
+  cursor.removeSelectedText();
+  QCOMPARE(document.findBlockByNumber(2).text(), QString("line5 := 5;"));
+  QCOMPARE(store->lineNumbers(), (QList<int>{2, 3, 5}));
+
+  // The same lines selected from the end of the line above.
+  select(cursor, 1, 11, 2, 11);
+  cursor.removeSelectedText();
+  QCOMPARE(document.findBlockByNumber(1).text(), QString("line5 := 5;"));
+  QCOMPARE(store->lineNumbers(), (QList<int>{2, 4}));
+}
+
+void TestBreakPointStore::deletingIntoLineDropsItsBreakPoint() {
+  QTextDocument document(numberedLines(6));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  for (const int lineNumber : {3, 5, 6}) {
+    store->setBreakPoint(lineNumber, true);
+  }
+  QTextCursor cursor(&document);
+  select(cursor, 3, 0, 5, 4);
+  cursor.removeSelectedText();
+  QCOMPARE(document.findBlockByNumber(2).text(), QString("5 := 5;"));
+  QCOMPARE(store->lineNumbers(), QList<int>{4});
+}
+
+void TestBreakPointStore::joiningLinesDropsJoinedBreakPoint() {
+  QTextDocument document(numberedLines(4));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  store->setBreakPoint(3, true);
+  store->setBreakPoint(4, true);
+  QTextCursor cursor(&document);
+  cursor.setPosition(document.findBlockByNumber(2).position());
+  cursor.deletePreviousChar();
+  QCOMPARE(document.blockCount(), 3);
+  QCOMPARE(store->lineNumbers(), QList<int>{3});
+}
+
+void TestBreakPointStore::deletingEmptyLineMovesNextLine() {
+  QTextDocument document("a := 1;\n\nb := 2;");
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  store->setBreakPoint(2, true);
+  store->setBreakPoint(3, true);
+  QTextCursor cursor(&document);
+  cursor.setPosition(document.findBlockByNumber(2).position());
+  cursor.deletePreviousChar();
+  QCOMPARE(document.findBlockByNumber(1).text(), QString("b := 2;"));
+  QCOMPARE(store->lineNumbers(), QList<int>{2});
+}
+
+void TestBreakPointStore::insertingLinesAtLineStartMovesLine() {
+  QTextDocument document(numberedLines(4));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  store->setBreakPoint(2, true);
+  store->setBreakPoint(3, true);
+  QTextCursor cursor(&document);
+  cursor.setPosition(document.findBlockByNumber(1).position());
+  cursor.insertText("x := 0;\ny := 0;\n");
+  QCOMPARE(document.findBlockByNumber(3).text(), QString("line2 := 2;"));
+  QCOMPARE(store->lineNumbers(), (QList<int>{4, 5}));
+
+  // Text without a line break stays on the line.
+  cursor.setPosition(document.findBlockByNumber(3).position());
+  cursor.insertText("  ");
+  QCOMPARE(store->lineNumbers(), (QList<int>{4, 5}));
+}
+
+void TestBreakPointStore::insertingLinesInsideLineKeepsLine() {
+  QTextDocument document(numberedLines(4));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  store->setBreakPoint(2, true);
+  store->setBreakPoint(3, true);
+  QTextCursor cursor(&document);
+  cursor.setPosition(document.findBlockByNumber(1).position() + 5);
+  cursor.insertText("\n\n");
+  QCOMPARE(store->lineNumbers(), (QList<int>{2, 5}));
+}
+
+void TestBreakPointStore::editsWithinLineKeepBreakPoints() {
+  QTextDocument document(numberedLines(4));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  store->setBreakPoint(2, true);
+  store->setBreakPoint(4, true);
+  QTextCursor cursor(&document);
+  select(cursor, 2, 0, 2, 5);
+  cursor.insertText("renamed");
+  select(cursor, 3, 0, 3, 11);
+  cursor.removeSelectedText();
+  QCOMPARE(store->lineNumbers(), (QList<int>{2, 4}));
+
+  // Later lines are still found at their new positions.
+  select(cursor, 3, 0, 4, 0);
+  cursor.removeSelectedText();
+  QCOMPARE(store->lineNumbers(), (QList<int>{2, 3}));
+}
+
+void TestBreakPointStore::changedLinesAreSignalled() {
+  QTextDocument document(numberedLines(6));
+  BreakPointStore* const store = BreakPointStore::of(&document);
+  store->setBreakPoint(1, true);
+  store->setBreakPoint(3, true);
+  store->setBreakPoint(5, true);
+  QSignalSpy spy(store, &BreakPointStore::breakPointChanged);
+  QTextCursor cursor(&document);
+  select(cursor, 3, 0, 4, 0);
+  cursor.removeSelectedText();
+  QCOMPARE(spy.count(), 3);
+  QCOMPARE(spy.at(0), (QList<QVariant>{3, false}));
+  QCOMPARE(spy.at(1), (QList<QVariant>{5, false}));
+  QCOMPARE(spy.at(2), (QList<QVariant>{4, true}));
+}
+
+QTEST_MAIN(TestBreakPointStore)
+#include "tst_breakpointstore.moc"
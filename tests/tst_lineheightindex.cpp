@@ -0,0 +1,131 @@
+#include <QList>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "lineheightindex.hpp"
+
+class TestLineHeightIndex : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void emptyIndex();
+  void offsetsAfterReset();
+  void lineAtBoundaries();
+  void randomEditsMatchPrefixSums();
+
+ private:
+  static qreal naiveOffsetOf(const QList<qreal>& heights, int line);
+  static int naiveLineAt(const QList<qreal>& heights, qreal offset);
+  static void compareWithNaive(const LineHeightIndex& index,
+                               const QList<qreal>& heights);
+};
+
+qreal TestLineHeightIndex::naiveOffsetOf(const QList<qreal>& heights,
+                                         int line) {
+  qreal offset = 0;
+  for (int i = 0; i < qBound(0, line, int(heights.size())); ++i) {
+    offset += heights.at(i);
+  }
+  return offset;
+}
+
+int TestLineHeightIndex::naiveLineAt(const QList<qreal>& heights,
+                                     qreal offset) {
+  if (heights.isEmpty()) {
+    return 0;
+  }
+  qreal end = 0;
+  int line = 0;
+  while (line < heights.size() && end + heights.at(line) <= offset) {
+    end += heights.at(line);
+    ++line;
+  }
+  return qMin(line, int(heights.size()) - 1);
+}
+
+void TestLineHeightIndex::compareWithNaive(const LineHeightIndex& index,
+                                           const QList<qreal>& heights) {
+  QCOMPARE(index.lineCount(), int(heights.size()));
+  for (int line = 0; line <= heights.size(); ++line) {
+    QCOMPARE(index.offsetOf(line), naiveOffsetOf(heights, line));
+  }
+  QCOMPARE(index.totalHeight(), naiveOffsetOf(heights, heights.size()));
+  for (int line = 0; line < heights.size(); ++line) {
+    const qreal start = naiveOffsetOf(heights, line);
+    QCOMPARE(index.heightAt(line), heights.at(line));
+    QCOMPARE(index.lineAt(start), naiveLineAt(heights, start));
+    QCOMPARE(index.lineAt(start + heights.at(line) / 2),
+             naiveLineAt(heights, start + heights.at(line) / 2));
+  }
+  QCOMPARE(index.lineAt(-1), naiveLineAt(heights, -1));
+  QCOMPARE(index.lineAt(index.totalHeight() + 100),
+           naiveLineAt(heights, index.totalHeight() + 100));
+}
+
+void TestLineHeightIndex::emptyIndex() {
+  const LineHeightIndex index;
+  QCOMPARE(index.lineCount(), 0);
+  QCOMPARE(index.totalHeight(), 0.0);
+  QCOMPARE(index.lineAt(10), 0);
+  QCOMPARE(index.heightAt(0), 0.0);
+}
+
+void TestLineHeightIndex::offsetsAfterReset() {
+  LineHeightIndex index;
+  index.reset(100, 12);
+  QCOMPARE(index.lineCount(), 100);
+  QCOMPARE(index.offsetOf(0), 0.0);
+  QCOMPARE(index.offsetOf(37), 37 * 12.0);
+  QCOMPARE(index.totalHeight(), 100 * 12.0);
+  QCOMPARE(index.lineAt(37 * 12), 37);
+  QCOMPARE(index.lineAt(37 * 12 - 1), 36);
+}
+
+void TestLineHeightIndex::lineAtBoundaries() {
+  LineHeightIndex index;
+  QList<qreal> heights{10, 0, 5, 20, 0, 0, 7};
+  index.reset(heights.size(), 0);
+  for (int line = 0; line < heights.size(); ++line) {
+    index.setHeightAt(line, heights.at(line));
+  }
+  compareWithNaive(index, heights);
+  QVERIFY(!index.setHeightAt(2, 5));
+  QVERIFY(!index.setHeightAt(heights.size(), 5));
+}
+
+void TestLineHeightIndex::randomEditsMatchPrefixSums() {
+  QRandomGenerator random(46);
+  LineHeightIndex index;
+  QList<qreal> heights(64, 14);
+  index.reset(heights.size(), 14);
+  for (int step = 0; step < 500; ++step) {
+    const int operation = random.bounded(3);
+    if (operation == 0) {
+      const int line = random.bounded(int(heights.size()) + 1);
+      const int count = random.bounded(1, 8);
+      const qreal height = random.bounded(1, 40);
+      index.insertLines(line, count, height);
+      heights.insert(line, count, height);
+    } else if (operation == 1 && !heights.isEmpty()) {
+      const int line = random.bounded(int(heights.size()));
+      const int count =
+          random.bounded(1, qMin(8, int(heights.size()) - line) + 1);
+      index.removeLines(line, count);
+      heights.remove(line, count);
+    } else if (!heights.isEmpty()) {
+      const int line = random.bounded(int(heights.size()));
+      const qreal height = random.bounded(0, 40);
+      index.setHeightAt(line, height);
+      heights[line] = height;
+    }
+    // Queries only on some steps, so edits are applied both to a stale and
+    // to a freshly built tree.
+    if (step % 3 == 0) {
+      compareWithNaive(index, heights);
+    }
+  }
+  compareWithNaive(index, heights);
+}
+
+QTEST_APPLESS_MAIN(TestLineHeightIndex)
+#include "tst_lineheightindex.moc"
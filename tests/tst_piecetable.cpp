@@ -0,0 +1,173 @@
+#include <QByteArray>
+#include <QList>
+#include <QRandomGenerator>
+#include <QTemporaryFile>
+#include <QTest>
+#include <memory>
+
+#include "piecetable.hpp"
+
+class TestPieceTable : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void emptyFile();
+  void linesAcrossCheckpoints();
+  void crlfLineEndings();
+  void insertAndRemoveAcrossPieces();
+  void splitAndJoinLines();
+  void randomEditsMatchByteArray();
+
+ private:
+  static std::unique_ptr<QTemporaryFile> createFile(const QByteArray& content);
+  static QByteArray numberedLines(int lineCount, const QByteArray& lineBreak);
+  static void compareWithBytes(const PieceTable& pieceTable,
+                               const QByteArray& bytes);
+};
+
+std::unique_ptr<QTemporaryFile> TestPieceTable::createFile(
+    const QByteArray& content) {
+  auto file = std::make_unique<QTemporaryFile>();
+  if (file->open()) {
+    file->write(content);
+    file->close();
+  }
+  return file;
+}
+
+QByteArray TestPieceTable::numberedLines(int lineCount,
+                                         const QByteArray& lineBreak) {
+  QByteArray bytes;
+  for (int line = 0; line < lineCount; ++line) {
+    bytes += "line " + QByteArray::number(line) +
+             QByteArray(line % 7, 'x') + lineBreak;
+  }
+  return bytes;
+}
+
+void TestPieceTable::compareWithBytes(const PieceTable& pieceTable,
+                                      const QByteArray& bytes) {
+  QCOMPARE(pieceTable.toByteArray(), bytes);
+  QCOMPARE(pieceTable.size(), qint64(bytes.size()));
+  const QList<QByteArray> lines = bytes.split('\n');
+  QCOMPARE(pieceTable.lineCount(), qint64(lines.size()));
+  qint64 offset = 0;
+  for (qsizetype line = 0; line < lines.size(); ++line) {
+    QByteArray expected = lines.at(line);
+    QCOMPARE(pieceTable.lineOffsetAt(line), offset);
+    offset += expected.size() + 1;
+    if (line + 1 < lines.size() && expected.endsWith('\r')) {
+      expected.chop(1);
+    }
+    QCOMPARE(pieceTable.lineLengthAt(line), qint64(expected.size()));
+    QCOMPARE(pieceTable.lineAt(line), QString::fromUtf8(expected));
+  }
+}
+
+void TestPieceTable::emptyFile() {
+  const auto file = createFile(QByteArray());
+  PieceTable pieceTable(file->fileName());
+  QCOMPARE(pieceTable.lineCount(), qint64(1));
+  QCOMPARE(pieceTable.lineAt(0), QString());
+  pieceTable.insert(0, "a\nb");
+  compareWithBytes(pieceTable, "a\nb");
+}
+
+void TestPieceTable::linesAcrossCheckpoints() {
+  // Several checkpoints, with lines right before and after each of them.
+  const QByteArray bytes = numberedLines(1000, "\n");
+  const auto file = createFile(bytes);
+  const PieceTable pieceTable(file->fileName());
+  compareWithBytes(pieceTable, bytes);
+  QCOMPARE(pieceTable.lineAt(255), QString("line 255xxx"));
+  QCOMPARE(pieceTable.lineAt(256), QString("line 256xxxx"));
+  QCOMPARE(pieceTable.lineAt(512), QString("line 512x"));
+}
+
+void TestPieceTable::crlfLineEndings() {
+  const QByteArray bytes = numberedLines(600, "\r\n") + "last";
+  const auto file = createFile(bytes);
+  PieceTable pieceTable(file->fileName());
+  compareWithBytes(pieceTable, bytes);
+  QCOMPARE(pieceTable.lineAt(0), QString("line 0"));
+  QCOMPARE(pieceTable.lineAt(600), QString("last"));
+
+  // A line break inserted between \r and \n ends a line with \r.
+  QByteArray expected = bytes;
+  const qint64 offset = pieceTable.lineOffsetAt(300) - 1;
+  pieceTable.insert(offset, "\r\nnew");
+  expected.insert(offset, "\r\nnew");
+  compareWithBytes(pieceTable, expected);
+}
+
+void TestPieceTable::insertAndRemoveAcrossPieces() {
+  QByteArray bytes = numberedLines(700, "\n");
+  const auto file = createFile(bytes);
+  PieceTable pieceTable(file->fileName());
+  for (const qint64 offset : {qint64(0), qint64(5), qint64(4000),
+                              qint64(bytes.size())}) {
+    pieceTable.insert(offset, "ins\nert");
+    bytes.insert(offset, "ins\nert");
+  }
+  compareWithBytes(pieceTable, bytes);
+
+  // Removals starting and ending inside different pieces.
+  pieceTable.remove(3, 10);
+  bytes.remove(3, 10);
+  pieceTable.remove(3990, 30);
+  bytes.remove(3990, 30);
+  compareWithBytes(pieceTable, bytes);
+
+  pieceTable.replaceLine(256, "replaced");
+  const qint64 start = pieceTable.lineOffsetAt(256);
+  bytes.replace(start, bytes.indexOf('\n', start) - start, "replaced");
+  compareWithBytes(pieceTable, bytes);
+
+  // Out of range edits are ignored.
+  pieceTable.insert(bytes.size() + 1, "x");
+  pieceTable.remove(bytes.size() - 1, 2);
+  compareWithBytes(pieceTable, bytes);
+}
+
+void TestPieceTable::splitAndJoinLines() {
+  QByteArray bytes = numberedLines(300, "\n");
+  const auto file = createFile(bytes);
+  PieceTable pieceTable(file->fileName());
+  const qint64 offset = pieceTable.lineOffsetAt(258) + 3;
+  pieceTable.insert(offset, "\n");
+  bytes.insert(offset, '\n');
+  compareWithBytes(pieceTable, bytes);
+  QCOMPARE(pieceTable.lineCount(), qint64(302));
+  pieceTable.remove(offset, 1);
+  bytes.remove(offset, 1);
+  compareWithBytes(pieceTable, bytes);
+}
+
+void TestPieceTable::randomEditsMatchByteArray() {
+  QRandomGenerator random(48);
+  QByteArray bytes = numberedLines(2000, "\n");
+  const auto file = createFile(bytes);
+  PieceTable pieceTable(file->fileName());
+  const QList<QByteArray> texts{"a", "\n", "bc\n", "\r\n", "\n\nxyz", "é"};
+  for (int step = 0; step < 300; ++step) {
+    if (random.bounded(2) == 0 || bytes.isEmpty()) {
+      const qint64 offset = random.bounded(int(bytes.size()) + 1);
+      const QByteArray& text = texts.at(random.bounded(int(texts.size())));
+      pieceTable.insert(offset, text);
+      bytes.insert(offset, text);
+    } else {
+      const qint64 offset = random.bounded(int(bytes.size()));
+      const qint64 length =
+          random.bounded(1, int(qMin(bytes.size() - offset, qint64(400))) + 1);
+      pieceTable.remove(offset, length);
+      bytes.remove(offset, length);
+    }
+    if (step % 25 == 0) {
+      compareWithBytes(pieceTable, bytes);
+    }
+  }
+  compareWithBytes(pieceTable, bytes);
+}
+
+QTEST_APPLESS_MAIN(TestPieceTable)
+#include "tst_piecetable.moc"
@@ -0,0 +1,104 @@
+#include <QList>
+#include <QString>
+#include <QTest>
+#include <atomic>
+#include <thread>
+
+#include "snapshotbuffer.hpp"
+
+class TestSnapshotBuffer : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void takeWithoutPublishFails();
+  void takeReturnsEachSnapshotOnce();
+  void takeReturnsLatestSnapshot();
+  void publishAfterTakeIsSeen();
+  void destinationIsOverwritten();
+  void concurrentSnapshotsAreOrdered();
+};
+
+void TestSnapshotBuffer::takeWithoutPublishFails() {
+  SnapshotBuffer<int> buffer;
+  int value = 7;
+  QVERIFY(!buffer.take(value));
+  QCOMPARE(value, 7);
+}
+
+void TestSnapshotBuffer::takeReturnsEachSnapshotOnce() {
+  SnapshotBuffer<int> buffer;
+  int value = 0;
+  buffer.publish(1);
+  QVERIFY(buffer.take(value));
+  QCOMPARE(value, 1);
+  QVERIFY(!buffer.take(value));
+  QCOMPARE(value, 1);
+}
+
+void TestSnapshotBuffer::takeReturnsLatestSnapshot() {
+  SnapshotBuffer<int> buffer;
+  int value = 0;
+  for (int i = 1; i <= 5; ++i) {
+    buffer.publish(i);
+  }
+  QVERIFY(buffer.take(value));
+  QCOMPARE(value, 5);
+  QVERIFY(!buffer.take(value));
+}
+
+void TestSnapshotBuffer::publishAfterTakeIsSeen() {
+  SnapshotBuffer<int> buffer;
+  int value = 0;
+  for (int i = 1; i <= 10; ++i) {
+    buffer.publish(i);
+    QVERIFY(buffer.take(value));
+    QCOMPARE(value, i);
+  }
+  buffer.publish(11);
+  buffer.publish(12);
+  QVERIFY(buffer.take(value));
+  QCOMPARE(value, 12);
+}
+
+void TestSnapshotBuffer::destinationIsOverwritten() {
+  SnapshotBuffer<QList<QString>> buffer;
+  QList<QString> destination{"a", "b", "c"};
+  buffer.publish(QList<QString>{"x"});
+  QVERIFY(buffer.take(destination));
+  QCOMPARE(destination, QList<QString>{"x"});
+}
+
+void TestSnapshotBuffer::concurrentSnapshotsAreOrdered() {
+  constexpr int SNAPSHOTS = 200000;
+  SnapshotBuffer<QList<int>> buffer;
+  std::atomic<bool> done = false;
+  std::thread producer([&buffer, &done]() -> void {
+    QList<int> snapshot(4);
+    for (int i = 1; i <= SNAPSHOTS; ++i) {
+      snapshot.fill(i);
+      buffer.publish(snapshot);
+    }
+    done.store(true, std::memory_order_release);
+  });
+  QList<int> snapshot;
+  int previous = 0;
+  bool ordered = true;
+  bool consistent = true;
+  while (true) {
+    const bool finished = done.load(std::memory_order_acquire);
+    if (buffer.take(snapshot)) {
+      ordered = ordered && snapshot.first() > previous;
+      consistent = consistent && snapshot.count(snapshot.first()) == 4;
+      previous = snapshot.first();
+    } else if (finished) {
+      break;
+    }
+  }
+  producer.join();
+  QVERIFY(ordered);
+  QVERIFY(consistent);
+  QCOMPARE(previous, SNAPSHOTS);
+}
+
+QTEST_APPLESS_MAIN(TestSnapshotBuffer)
+#include "tst_snapshotbuffer.moc"
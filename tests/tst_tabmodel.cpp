@@ -0,0 +1,151 @@
+#include <QFile>
+#include <QList>
+#include <QTest>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include "editormodel.hpp"
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+class TestTabModel : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void unmodifiedAfterLoading();
+  void editsAfterMatchingContentAreModified();
+  void undoingEditsIsUnmodified();
+  void copyKeepsModifiedState();
+  void residentMemoryWithManyLargeTabs();
+
+ private:
+  static QString largeText(int tab, int lineCount);
+  static qint64 residentBytes();
+};
+
+QString TestTabModel::largeText(int tab, int lineCount) {
+  QString text;
+  text.reserve(lineCount * 64);
+  for (int line = 0; line < lineCount; ++line) {
+    text += QString("x%1 := x%2 + %3; // tab %4 padding padding padding\n")
+                .arg(line % 97)
+                .arg(line % 89)
+                .arg(line)
+                .arg(tab);
+  }
+  return text;
+}
+
+qint64 TestTabModel::residentBytes() {
+#ifdef Q_OS_LINUX
+  QFile statm("/proc/self/statm");
+  if (!statm.open(QIODevice::ReadOnly)) {
+    return -1;
+  }
+  const QList<QByteArray> fields = statm.readAll().split(' ');
+  if (fields.size() < 2) {
+    return -1;
+  }
+  return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+  return -1;
+#endif
+}
+
+void TestTabModel::unmodifiedAfterLoading() {
+  TabModel tab("main", std::nullopt, "a := 1;\n");
+  QTextDocument document(tab.storedText());
+  tab.setTextDocument(&document);
+  tab.releaseStoredText();
+  QVERIFY(!tab.updateModified());
+  QVERIFY(!tab.isModified());
+  QVERIFY(tab.storedText().isEmpty());
+}
+
+void TestTabModel::editsAfterMatchingContentAreModified() {
+  TabModel tab("main", std::nullopt, "a := 1;\n");
+  QTextDocument document(tab.storedText());
+  tab.setTextDocument(&document);
+  tab.releaseStoredText();
+
+  // The first edit leaves the content equal to the saved text.
+  QTextCursor cursor(&document);
+  cursor.select(QTextCursor::Document);
+  cursor.insertText("a := 1;\n");
+  QVERIFY(document.isModified());
+  tab.updateModified();
+  QVERIFY(!tab.isModified());
+
+  // Later edits no longer change the modification state of the document,
+  // they must still mark the tab as modified before it is compared again.
+  cursor.insertText("b := 2;\n");
+  QVERIFY(tab.markContentChanged());
+  QVERIFY(tab.isModified());
+  QVERIFY(!tab.updateModified());
+  QVERIFY(tab.isModified());
+}
+
+void TestTabModel::undoingEditsIsUnmodified() {
+  TabModel tab("main", std::nullopt, "a := 1;\n");
+  QTextDocument document(tab.storedText());
+  tab.setTextDocument(&document);
+  QTextCursor cursor(&document);
+  cursor.insertText("b := 2;\n");
+  tab.markContentChanged();
+  QVERIFY(tab.isModified());
+  document.undo();
+  QVERIFY(tab.markContentChanged());
+  QVERIFY(!tab.isModified());
+}
+
+void TestTabModel::copyKeepsModifiedState() {
+  TabModel tab("main", std::nullopt, "a := 1;\n");
+  QTextDocument document(tab.storedText());
+  tab.setTextDocument(&document);
+  QTextCursor cursor(&document);
+  cursor.insertText("b := 2;\n");
+  tab.updateModified();
+  QVERIFY(tab.isModified());
+  const TabModel copy(tab);
+  QVERIFY(copy.isModified());
+}
+
+void TestTabModel::residentMemoryWithManyLargeTabs() {
+#ifndef Q_OS_LINUX
+  QSKIP("Resident memory is read from /proc/self/statm");
+#endif
+  constexpr int TABS = 16;
+  constexpr int LINES = 32 * 1024;
+  const qint64 baseline = residentBytes();
+  QList<QSharedPointer<TabModel>> tabs;
+  QList<QSharedPointer<QTextDocument>> documents;
+  qint64 storedTextBytes = 0;
+  for (int i = 0; i < TABS; ++i) {
+    QString text = largeText(i, LINES);
+    storedTextBytes += text.size() * sizeof(QChar);
+    tabs.append(QSharedPointer<TabModel>(
+        new TabModel(QString("tab%1").arg(i), std::nullopt, text)));
+    text.clear();
+    documents.append(QSharedPointer<QTextDocument>(new QTextDocument()));
+    documents.last()->setPlainText(tabs.last()->storedText());
+    tabs.last()->setTextDocument(documents.last().data());
+  }
+  const qint64 withStoredText = residentBytes();
+  for (const QSharedPointer<TabModel>& tab : std::as_const(tabs)) {
+    tab->releaseStoredText();
+  }
+  const qint64 released = residentBytes();
+  qInfo() << "Resident bytes per tab with stored text:"
+          << (withStoredText - baseline) / TABS
+          << "after releasing it:" << (released - baseline) / TABS;
+  QVERIFY(withStoredText > 0 && released > 0);
+  QVERIFY(withStoredText - released >= storedTextBytes * 3 / 4);
+  for (const QSharedPointer<TabModel>& tab : std::as_const(tabs)) {
+    QVERIFY(!tab->isModified());
+  }
+}
+
+QTEST_MAIN(TestTabModel)
+#include "tst_tabmodel.moc"
@@ -0,0 +1,97 @@
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "variablesstatedelta.hpp"
+
+class TestVariablesStateDelta : public QObject {
+  Q_OBJECT
+
+ private slots:
+  void equalStatesGiveEmptyDelta();
+  void insertedVariablesAreAdded();
+  void missingVariablesAreRemoved();
+  void differentValuesAreChanged();
+  void mixedChanges();
+  void randomStatesApplyToNext();
+
+ private:
+  static VariablesState apply(VariablesState state,
+                              const VariablesStateDelta& delta);
+};
+
+VariablesState TestVariablesStateDelta::apply(
+    VariablesState state, const VariablesStateDelta& delta) {
+  for (const SymbolId id : delta.removed()) {
+    state.remove(id);
+  }
+  for (const VariableEntry& entry : delta.added()) {
+    state.insert(entry.first, entry.second);
+  }
+  for (const VariableEntry& entry : delta.changed()) {
+    state.insert(entry.first, entry.second);
+  }
+  return state;
+}
+
+void TestVariablesStateDelta::equalStatesGiveEmptyDelta() {
+  const VariablesState state{{0, 1}, {1, 2}};
+  QVERIFY(VariablesStateDelta(state, state).isEmpty());
+  QVERIFY(VariablesStateDelta(VariablesState(), VariablesState()).isEmpty());
+  QVERIFY(VariablesStateDelta().isEmpty());
+}
+
+void TestVariablesStateDelta::insertedVariablesAreAdded() {
+  const VariablesStateDelta delta(VariablesState{{1, 10}},
+                                  VariablesState{{0, 5}, {1, 10}, {4, 7}});
+  QCOMPARE(delta.added(),
+           (QList<VariableEntry>{VariableEntry(0, 5), VariableEntry(4, 7)}));
+  QVERIFY(delta.removed().isEmpty());
+  QVERIFY(delta.changed().isEmpty());
+}
+
+void TestVariablesStateDelta::missingVariablesAreRemoved() {
+  const VariablesStateDelta delta(VariablesState{{0, 5}, {1, 10}, {4, 7}},
+                                  VariablesState{{1, 10}});
+  QCOMPARE(delta.removed(), (QList<SymbolId>{0, 4}));
+  QVERIFY(delta.added().isEmpty());
+  QVERIFY(delta.changed().isEmpty());
+}
+
+void TestVariablesStateDelta::differentValuesAreChanged() {
+  const VariablesStateDelta delta(VariablesState{{0, 5}, {1, 10}},
+                                  VariablesState{{0, 6}, {1, 10}});
+  QCOMPARE(delta.changed(), (QList<VariableEntry>{VariableEntry(0, 6)}));
+  QVERIFY(delta.added().isEmpty());
+  QVERIFY(delta.removed().isEmpty());
+}
+
+void TestVariablesStateDelta::mixedChanges() {
+  const VariablesState previous{{0, 1}, {2, 3}, {3, 4}, {7, 8}};
+  const VariablesState next{{1, 1}, {2, 30}, {3, 4}, {9, 0}};
+  const VariablesStateDelta delta(previous, next);
+  QCOMPARE(delta.added(),
+           (QList<VariableEntry>{VariableEntry(1, 1), VariableEntry(9, 0)}));
+  QCOMPARE(delta.removed(), (QList<SymbolId>{0, 7}));
+  QCOMPARE(delta.changed(), (QList<VariableEntry>{VariableEntry(2, 30)}));
+  QCOMPARE(apply(previous, delta), next);
+}
+
+void TestVariablesStateDelta::randomStatesApplyToNext() {
+  QRandomGenerator random(28);
+  VariablesState previous;
+  for (int step = 0; step < 1000; ++step) {
+    VariablesState next;
+    for (SymbolId id = 0; id < 24; ++id) {
+      if (random.bounded(3) != 0) {
+        next.insert(id, random.bounded(-4, 4));
+      }
+    }
+    const VariablesStateDelta delta(previous, next);
+    QCOMPARE(apply(previous, delta), next);
+    QCOMPARE(delta.isEmpty(), previous == next);
+    previous = next;
+  }
+}
+
+QTEST_APPLESS_MAIN(TestVariablesStateDelta)
+#include "tst_variablesstatedelta.moc"